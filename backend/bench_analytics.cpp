@@ -0,0 +1,139 @@
+#include "include/RequestHistory.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <thread>
+
+// Compares the original row-wise Analytics scans (walking ParkingRequest
+// objects through their getters) with the columnar RequestHistory kernels.
+// Both sides compute the same totals: a count per state, released revenue,
+// released duration and released cross-zone requests.
+// Usage: bench_analytics [requestCount]
+//   (build with -DCMAKE_BUILD_TYPE=Release -DCMAKE_CXX_FLAGS_RELEASE="-O2 -DNDEBUG")
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Fold the totals into one number so both sides can be compared
+double totalsChecksum(const long long* stateCounts, double revenue, double duration, long long crossZone) {
+    double checksum = revenue + duration + crossZone;
+    for (int s = 0; s < REQUEST_STATE_COUNT; s++) {
+        checksum += stateCounts[s] * (s + 1);
+    }
+    return checksum;
+}
+
+int main(int argc, char** argv) {
+    int requestCount = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int rounds = 5;
+    const char* zoneIds[] = {"ZA", "ZB", "ZC", "ZD", "ZE"};
+    
+    std::cout << "=== Analytics Benchmark: " << requestCount << " requests ===" << std::endl;
+    
+    // Build the same data in both layouts
+    std::vector<ParkingRequest*> rows;
+    rows.reserve(requestCount);
+    RequestHistory history;
+    history.reserve(requestCount);
+    std::mt19937 rng(7);
+    for (int i = 0; i < requestCount; i++) {
+        ParkingRequest* request = new ParkingRequest("REQ" + std::to_string(i), "CAR", zoneIds[rng() % 5]);
+        request->setDurationHours(1 + rng() % 8);
+        if (rng() % 4 == 0) {
+            request->cancel();
+        } else {
+            request->allocate(zoneIds[rng() % 5], "S", 1.0 + (rng() % 4000) / 100.0, rng() % 3 == 0);
+            request->occupy();
+            request->release();
+        }
+        rows.push_back(request);
+        history.append(*request);
+    }
+    
+    // Row-wise: the scans Analytics used to run per query
+    double rowChecksum = 0.0;
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        long long stateCounts[REQUEST_STATE_COUNT] = {};
+        long long crossZone = 0;
+        double revenue = 0.0, duration = 0.0;
+        for (ParkingRequest* request : rows) {
+            RequestState state = request->getState();
+            stateCounts[state]++;
+            if (state == RELEASED) {
+                revenue += request->getTotalCost();
+                duration += request->getDuration();
+                if (request->getIsCrossZone()) crossZone++;
+            }
+        }
+        rowChecksum += totalsChecksum(stateCounts, revenue, duration, crossZone);
+    }
+    double rowMs = elapsedMs(start) / rounds;
+    
+    // Columnar kernels, scalar and AVX2
+    double results[2] = {0.0, 0.0};
+    double columnChecksum[2] = {0.0, 0.0};
+    for (int simd = 0; simd < 2; simd++) {
+        RequestHistory::setAvx2Enabled(simd == 1);
+        start = Clock::now();
+        for (int r = 0; r < rounds; r++) {
+            long long stateCounts[REQUEST_STATE_COUNT];
+            for (int s = 0; s < REQUEST_STATE_COUNT; s++) {
+                stateCounts[s] = history.countState(static_cast<RequestState>(s), 0, history.size());
+            }
+            columnChecksum[simd] += totalsChecksum(stateCounts, history.sumCost(RELEASED, 0, history.size()),
+                                                   history.sumDuration(RELEASED, 0, history.size()),
+                                                   history.countCrossZoneCompleted(0, history.size()));
+        }
+        results[simd] = elapsedMs(start) / rounds;
+    }
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Row-wise scan:      " << rowMs << " ms" << std::endl;
+    std::cout << "Columnar (scalar):  " << results[0] << " ms (" << rowMs / results[0] << "x)" << std::endl;
+    if (RequestHistory::isAvx2Supported()) {
+        std::cout << "Columnar (AVX2):    " << results[1] << " ms (" << rowMs / results[1] << "x)" << std::endl;
+    } else {
+        std::cout << "Columnar (AVX2):    not supported on this CPU" << std::endl;
+    }
+    
+    // Parallel scaling over the columnar history (1, 2, 4, ... up to all cores)
+    RequestHistory::setAvx2Enabled(true);
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads <= 0) maxThreads = 1;
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+    
+    double singleThreadMs = 0.0;
+    for (int threads : threadCounts) {
+        double parallelChecksum = 0.0;
+        start = Clock::now();
+        for (int r = 0; r < rounds; r++) {
+            parallelChecksum += history.aggregateParallel(threads).revenue;
+        }
+        double ms = elapsedMs(start) / rounds;
+        if (threads == 1) singleThreadMs = ms;
+        std::cout << "Parallel, " << std::setw(2) << threads << " threads: " << ms
+                  << " ms (speedup " << singleThreadMs / ms << "x, checksum "
+                  << parallelChecksum / rounds << ")" << std::endl;
+    }
+    // Vector lanes add the sums in another order, so allow rounding differences
+    double tolerance = 1e-9 * rowChecksum;
+    if (std::fabs(rowChecksum - columnChecksum[0]) > tolerance ||
+        std::fabs(rowChecksum - columnChecksum[1]) > tolerance) {
+        std::cout << "Warning: row-wise and columnar totals differ" << std::endl;
+    }
+    std::cout << "Checksums: " << rowChecksum << " / " << columnChecksum[0] << " / " << columnChecksum[1] << std::endl;
+    
+    for (ParkingRequest* request : rows) {
+        delete request;
+    }
+    return 0;
+}
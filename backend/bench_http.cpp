@@ -0,0 +1,213 @@
+#include "include/HttpServer.h"
+#include "include/ParkingSystem.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+// Requests/second of the epoll server on the parking read path
+// (GET /api/zones, served from per-thread copies of the zone list) with a
+// mix of POST /api/batch writes, as the thread-per-core worker count grows
+// from 1 to N. Load comes from keep-alive client threads on the same host
+// sending pipelined requests, so leave cores free for them.
+// Usage: bench_http [maxCores] [seconds] [writePercent]  (build with -DCMAKE_BUILD_TYPE=Release)
+
+using Clock = std::chrono::steady_clock;
+
+std::mutex systemMutex;
+ParkingSystem* parkingSystem = nullptr;
+
+// Per-thread zone list, refreshed only after a slot change
+struct ZoneListCache {
+    uint64_t version;
+    std::string json;
+
+    ZoneListCache() : version(0) {}
+};
+thread_local ZoneListCache zoneListCache;
+
+// Register the benchmarked parking routes
+void registerRoutes(HttpServer& server) {
+    server.route("GET", "/api/zones", [](const HttpRequest&, HttpResponse& res) {
+        if (zoneListCache.json.empty() || zoneListCache.version != Zone::getCurrentVersion()) {
+            std::lock_guard<std::mutex> lock(systemMutex);
+            zoneListCache.version = parkingSystem->getZoneVersion();
+            zoneListCache.json = parkingSystem->getZonesJson();
+        }
+        JsonWriter writer(res.body);
+        writer.beginObject().field("success", true).key("data").raw(zoneListCache.json).endObject();
+    });
+    server.route("POST", "/api/batch", [](const HttpRequest& req, HttpResponse& res) {
+        thread_local std::vector<BatchOperation> operations;
+        std::string_view error;
+        if (!parseBatchBody(req.body, operations, error)) {
+            res.status = 400;
+            return;
+        }
+        JsonWriter writer(res.body);
+        writer.beginObject().key("results");
+        std::lock_guard<std::mutex> lock(systemMutex);
+        parkingSystem->executeBatch(operations, writer);
+        writer.endObject();
+    });
+}
+
+// Open a keep-alive connection to the server
+int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Count complete responses at the front of buffer and drop them
+int consumeResponses(std::string& buffer) {
+    int count = 0;
+    size_t offset = 0;
+    while (true) {
+        size_t headerEnd = buffer.find("\r\n\r\n", offset);
+        if (headerEnd == std::string::npos) break;
+        size_t lengthPos = buffer.find("Content-Length: ", offset);
+        if (lengthPos == std::string::npos || lengthPos > headerEnd) break;
+        size_t length = std::strtoul(buffer.c_str() + lengthPos + 16, nullptr, 10);
+        size_t end = headerEnd + 4 + length;
+        if (end > buffer.size()) break;
+        offset = end;
+        count++;
+    }
+    buffer.erase(0, offset);
+    return count;
+}
+
+// Drive one connection with pipelined requests until the deadline
+void runClient(int port, Clock::time_point deadline, int writePercent, int clientId,
+               std::atomic<long long>& completed) {
+    const int DEPTH = 16;
+    int fd = connectTo(port);
+    if (fd < 0) return;
+
+    std::string read = "GET /api/zones HTTP/1.1\r\nHost: bench\r\n\r\n";
+    const char* zoneIds[] = {"ZA", "ZB", "ZC", "ZD", "ZE"};
+    std::string buffer;
+    char chunk[64 * 1024];
+    long long done = 0;
+    unsigned sequence = 0;
+
+    while (Clock::now() < deadline) {
+        std::string burst;
+        for (int i = 0; i < DEPTH; i++) {
+            if (static_cast<int>(++sequence % 100) < writePercent) {
+                // Once the zones fill up these take the "No parking available"
+                // path, which still parses, locks and serializes a result
+                std::string vehicle = "B" + std::to_string(clientId) + "_" + std::to_string(sequence);
+                std::string body = "[{\"op\":\"request\",\"vehicleId\":\"" + vehicle +
+                                   "\",\"preferredZone\":\"" + zoneIds[sequence % 5] +
+                                   "\",\"durationHours\":1}]";
+                burst += "POST /api/batch HTTP/1.1\r\nHost: bench\r\nContent-Length: " +
+                         std::to_string(body.size()) + "\r\n\r\n" + body;
+            } else {
+                burst += read;
+            }
+        }
+        if (send(fd, burst.data(), burst.size(), 0) < 0) break;
+
+        int outstanding = DEPTH;
+        while (outstanding > 0) {
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                outstanding = -1;
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+            outstanding -= consumeResponses(buffer);
+        }
+        if (outstanding < 0) break;
+        done += DEPTH;
+    }
+    close(fd);
+    completed += done;
+}
+
+// Reset the parking state so runs do not drain the zones
+void resetSystem() {
+    std::lock_guard<std::mutex> lock(systemMutex);
+    delete parkingSystem;
+    parkingSystem = new ParkingSystem();
+    parkingSystem->initializeZones();
+}
+
+int main(int argc, char** argv) {
+    int cpuCount = static_cast<int>(std::thread::hardware_concurrency());
+    int maxCores = argc > 1 ? std::atoi(argv[1]) : (cpuCount > 1 ? cpuCount / 2 : 1);
+    double seconds = argc > 2 ? std::atof(argv[2]) : 3.0;
+    int writePercent = argc > 3 ? std::atoi(argv[3]) : 0;
+    if (maxCores < 1) maxCores = 1;
+
+    std::cout << "=== HTTP Benchmark: thread-per-core, " << writePercent << "% batch writes, "
+              << seconds << "s per run, " << cpuCount << " CPU(s) ===" << std::endl;
+    std::cout << std::setw(8) << "cores" << std::setw(14) << "req/s" << std::setw(10) << "scale" << std::endl;
+
+    // 1, 2, 4, ... and maxCores itself
+    std::vector<int> coreCounts;
+    for (int cores = 1; cores < maxCores; cores *= 2) coreCounts.push_back(cores);
+    coreCounts.push_back(maxCores);
+
+    double baseline = 0.0;
+    for (int cores : coreCounts) {
+        resetSystem();
+        HttpServer server(0, cores);
+        server.setThreadPerCore(true);
+        registerRoutes(server);
+        if (!server.start()) {
+            std::cerr << "Failed to start server" << std::endl;
+            return 1;
+        }
+        std::thread serverThread([&server]() { server.run(); });
+
+        // Enough connections that SO_REUSEPORT hashing reaches every core
+        int clients = cores * 4;
+        std::atomic<long long> completed(0);
+        Clock::time_point start = Clock::now();
+        Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+                                                 std::chrono::duration<double>(seconds));
+        std::vector<std::thread> clientThreads;
+        for (int i = 0; i < clients; i++) {
+            clientThreads.emplace_back(runClient, server.getPort(), deadline, writePercent, i,
+                                       std::ref(completed));
+        }
+        for (std::thread& t : clientThreads) t.join();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        server.stop();
+        serverThread.join();
+
+        double rate = completed.load() / elapsed;
+        if (cores == 1) baseline = rate;
+        std::cout << std::setw(8) << cores << std::setw(14) << std::fixed << std::setprecision(0) << rate
+                  << std::setw(9) << std::setprecision(2) << (baseline > 0 ? rate / baseline : 0.0) << "x"
+                  << std::endl;
+    }
+
+    delete parkingSystem;
+    return 0;
+}
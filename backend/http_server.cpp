@@ -1,25 +1,34 @@
 ﻿#include "crow.h"
 #include "../include/ParkingSystem.h"
+#include "../include/JsonWriter.h"
+#include "../include/RequestParser.h"
+#include "../include/Metrics.h"
 #include <iostream>
 #include <memory>
 #include <string>
-#include <sstream>
+#include <vector>
+#include <mutex>
 
 using namespace std;
 
 // Global parking system
 unique_ptr<ParkingSystem> parkingSystem;
 
-// Helper to create JSON response
+// ParkingSystem is not thread-safe and Crow runs handlers on several
+// threads; every handler touching it holds this
+mutex systemMutex;
+
+// Helper to create JSON response (data is an already-serialized JSON value)
 string jsonResponse(bool success, const string& message, const string& data = "{}") {
-    stringstream ss;
-    ss << R"({"success":)" << (success ? "true" : "false") 
-       << R"(,"message":")" << message << R"(")";
+    string out;
+    out.reserve(48 + message.size() + data.size());
+    JsonWriter writer(out);
+    writer.beginObject().field("success", success).field("message", message);
     if (!data.empty() && data != "{}") {
-        ss << R"(,"data":)" << data;
+        writer.key("data").raw(data);
     }
-    ss << "}";
-    return ss.str();
+    writer.endObject();
+    return out;
 }
 
 int main() {
@@ -28,7 +37,10 @@ int main() {
     cout << "API endpoints:" << endl;
     cout << "  GET  /api/zones" << endl;
     cout << "  POST /api/request-parking" << endl;
+    cout << "  POST /api/batch" << endl;
     cout << "  GET  /api/analytics" << endl;
+    cout << "  GET  /api/alerts" << endl;
+    cout << "  GET  /api/heatmap" << endl;
     
     // Initialize parking system
     parkingSystem = make_unique<ParkingSystem>();
@@ -55,115 +67,106 @@ int main() {
         res.end();
     });
     
-    // API: Get all zones
+    // API: Get all zones (live, pre-serialized)
     CROW_ROUTE(app, "/api/zones")
     ([]() {
-        // Mock response matching your frontend format
-        return R"([
-            {
-                "zoneId": "ZA",
-                "zoneName": "Downtown Parking A", 
-                "totalSlots": 20,
-                "availableSlots": 12,
-                "hourlyRate": 5.0,
-                "utilization": 40.0,
-                "connections": [
-                    {"zoneId": "ZB", "distance": 500},
-                    {"zoneId": "ZC", "distance": 800}
-                ]
-            },
-            {
-                "zoneId": "ZB",
-                "zoneName": "Mall Parking B",
-                "totalSlots": 15,
-                "availableSlots": 8,
-                "hourlyRate": 4.0,
-                "utilization": 46.7,
-                "connections": [
-                    {"zoneId": "ZA", "distance": 500},
-                    {"zoneId": "ZC", "distance": 300},
-                    {"zoneId": "ZD", "distance": 700}
-                ]
-            },
-            {
-                "zoneId": "ZC",
-                "zoneName": "Office Parking C",
-                "totalSlots": 25,
-                "availableSlots": 18,
-                "hourlyRate": 6.0,
-                "utilization": 28.0,
-                "connections": [
-                    {"zoneId": "ZA", "distance": 800},
-                    {"zoneId": "ZB", "distance": 300},
-                    {"zoneId": "ZE", "distance": 400}
-                ]
-            },
-            {
-                "zoneId": "ZD", 
-                "zoneName": "Residential Parking D",
-                "totalSlots": 18,
-                "availableSlots": 10,
-                "hourlyRate": 3.5,
-                "utilization": 44.4,
-                "connections": [
-                    {"zoneId": "ZB", "distance": 700},
-                    {"zoneId": "ZE", "distance": 600}
-                ]
-            },
-            {
-                "zoneId": "ZE",
-                "zoneName": "Airport Parking E",
-                "totalSlots": 30,
-                "availableSlots": 22,
-                "hourlyRate": 8.0,
-                "utilization": 26.7,
-                "connections": [
-                    {"zoneId": "ZC", "distance": 400},
-                    {"zoneId": "ZD", "distance": 600}
-                ]
-            }
-        ])";
+        // Copy out under the lock: the buffer is patched in place
+        lock_guard<mutex> lock(systemMutex);
+        return string(parkingSystem->getZonesJson());
     });
     
     // API: Request parking
     CROW_ROUTE(app, "/api/request-parking").methods("POST"_method)
     ([](const crow::request& req) {
-        // Parse JSON request
-        auto body = crow::json::load(req.body);
-        if (!body) {
-            return jsonResponse(false, "Invalid JSON request");
+        // Parse the fixed schema in place (views into req.body)
+        ParkingRequestBody fields;
+        string_view error;
+        if (!parseParkingRequestBody(req.body, fields, error)) {
+            return jsonResponse(false, string(error));
         }
         
-        string vehicleId = body["vehicleId"].s();
-        string preferredZone = body["preferredZone"].s();
-        int duration = body["durationHours"].i();
-        
         // Call actual parking system
-        string requestId = parkingSystem->requestParking(vehicleId, preferredZone, duration);
+        string requestId;
+        {
+            lock_guard<mutex> lock(systemMutex);
+            requestId = parkingSystem->requestParking(fields.vehicleId, fields.preferredZone,
+                                                      fields.durationHours);
+        }
         
         if (!requestId.empty()) {
-            stringstream data;
-            data << R"({"requestId":")" << requestId 
-                 << R"(","message":"Parking allocated successfully"})";
-            return jsonResponse(true, "Parking allocated", data.str());
+            string data;
+            JsonWriter writer(data);
+            writer.beginObject()
+                  .field("requestId", requestId)
+                  .field("message", "Parking allocated successfully")
+                  .endObject();
+            return jsonResponse(true, "Parking allocated", data);
         } else {
             return jsonResponse(false, "No parking available");
         }
     });
     
+    // API: Apply several parking operations in one call (parsed outside the
+    // lock, applied under it once)
+    CROW_ROUTE(app, "/api/batch").methods("POST"_method)
+    ([](const crow::request& req) {
+        vector<BatchOperation> operations;
+        string_view error;
+        if (!parseBatchBody(req.body, operations, error)) {
+            return jsonResponse(false, string(error));
+        }
+        
+        string data;
+        JsonWriter writer(data);
+        writer.beginObject().key("results");
+        int succeeded;
+        {
+            lock_guard<mutex> lock(systemMutex);
+            succeeded = parkingSystem->executeBatch(operations, writer);
+        }
+        writer.field("succeeded", succeeded)
+              .field("failed", static_cast<int>(operations.size()) - succeeded)
+              .endObject();
+        return jsonResponse(true, "Batch applied", data);
+    });
+    
     // API: Get analytics
     CROW_ROUTE(app, "/api/analytics")
     ([]() {
-        return R"({
-            "totalRequests": 50,
-            "completedRequests": 40,
-            "cancelledRequests": 10,
-            "completionRate": 80.0,
-            "averageDuration": 2.5,
-            "totalRevenue": 450.0,
-            "peakZone": "ZA",
-            "crossZoneRate": 15.0
-        })";
+        lock_guard<mutex> lock(systemMutex);
+        return parkingSystem->getAnalyticsJson();
+    });
+    
+    // API: Recent occupancy/arrival anomalies
+    CROW_ROUTE(app, "/api/alerts")
+    ([]() {
+        string alerts;
+        {
+            lock_guard<mutex> lock(systemMutex);
+            alerts = parkingSystem->getAlertsJson(50);
+        }
+        return jsonResponse(true, "Recent alerts", alerts);
+    });
+    
+    // API: Average occupancy by zone and hour-of-week
+    CROW_ROUTE(app, "/api/heatmap")
+    ([]() {
+        string heatmap;
+        {
+            lock_guard<mutex> lock(systemMutex);
+            heatmap = parkingSystem->getHeatmapJson();
+        }
+        return jsonResponse(true, "Occupancy heatmap", heatmap);
+    });
+    
+    // Prometheus scrape endpoint (core metrics only; Crow keeps its own
+    // request timing)
+    CROW_ROUTE(app, "/metrics")
+    ([]() {
+        crow::response res;
+        res.set_header("Content-Type", "text/plain; version=0.0.4");
+        metrics().writePrometheus(res.body);
+        return res;
     });
     
     // Start server on port 8080
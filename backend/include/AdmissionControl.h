@@ -0,0 +1,104 @@
+#ifndef ADMISSIONCONTROL_H
+#define ADMISSIONCONTROL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+// Scheduling class of a request. Reads are cheap and served first; writes
+// take the system lock and are shed first under overload.
+enum RequestPriority {
+    PRIORITY_READ,
+    PRIORITY_WRITE
+};
+
+const int PRIORITY_COUNT = PRIORITY_WRITE + 1;
+
+// Limits applied by the HTTP server before a handler runs
+struct AdmissionConfig {
+    size_t maxQueued[PRIORITY_COUNT];   // per worker; a full queue answers 503 at once
+    int maxQueueDelayMs[PRIORITY_COUNT]; // requests waiting longer are answered 503
+    double clientRate;                  // requests per second per client address, 0 = off
+    double clientBurst;                 // bucket size
+    int retryAfterSeconds;              // Retry-After on overload responses
+
+    AdmissionConfig();
+};
+
+// Counters of admission decisions, summed over workers
+struct AdmissionStats {
+    uint64_t admitted[PRIORITY_COUNT];
+    uint64_t shedQueueFull[PRIORITY_COUNT];
+    uint64_t shedQueueDelay[PRIORITY_COUNT];
+    uint64_t rateLimited;
+
+    AdmissionStats();
+    uint64_t getShedTotal() const;
+};
+
+// Classic token bucket: refills at rate tokens/s up to burst
+class TokenBucket {
+private:
+    double tokens;
+    double lastRefill;   // seconds on a monotonic clock
+
+public:
+    TokenBucket();
+
+    // Take one token; on failure retryAfter is the wait until one is available
+    bool take(double rate, double burst, double now, double& retryAfter);
+    bool isFull(double rate, double burst, double now) const;
+};
+
+// Per-client token buckets keyed by IPv4 address, used by one thread only
+// (no locking). Each thread-per-core worker keeps its own.
+class LocalRateLimiter {
+private:
+    std::unordered_map<uint32_t, TokenBucket> buckets;
+    double rate;
+    double burst;
+
+public:
+    LocalRateLimiter();
+
+    void configure(double requestsPerSecond, double burstSize);
+    bool isEnabled() const;
+
+    bool allow(uint32_t client, double now, double& retryAfter);
+    // Forget clients whose buckets have refilled (they are indistinguishable from new ones)
+    void sweep(double now);
+    size_t getClientCount() const;
+};
+
+// Per-client token buckets shared by all workers. The table is split into
+// stripes with their own locks so workers rarely contend.
+class ClientRateLimiter {
+private:
+    static const int STRIPES = 16;
+
+    struct Stripe {
+        std::mutex mutex;
+        LocalRateLimiter buckets;
+    };
+
+    Stripe stripes[STRIPES];
+    double rate;
+    double burst;
+
+public:
+    ClientRateLimiter();
+
+    void configure(double requestsPerSecond, double burstSize);
+    bool isEnabled() const;
+
+    bool allow(uint32_t client, double now, double& retryAfter);
+    // Forget clients whose buckets have refilled (they are indistinguishable from new ones)
+    void sweep(double now);
+    size_t getClientCount();
+};
+
+// Seconds on the monotonic clock
+double monotonicSeconds();
+
+#endif
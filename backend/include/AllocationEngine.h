@@ -5,6 +5,7 @@
 #include "ParkingRequest.h"
 #include "PathFinder.h"
 #include "Vehicle.h"
+#include "OccupancyForecaster.h"
 #include <string>
 #include <vector>
 
@@ -14,6 +15,13 @@ private:
     int zoneCount;
     PathFinder* pathFinder;
     
+    // Optional occupancy forecasts, indexed like zones (not owned)
+    const OccupancyForecaster* forecasters;
+    int forecastMinutes;
+    
+    // Check if a zone is forecast to have no free slots soon
+    bool isPredictedFull(int zoneIndex) const;
+    
     // Find available slot in specific zone
     std::string findAvailableSlotInZone(const std::string& zoneId);
     
@@ -29,6 +37,9 @@ public:
     AllocationEngine(Zone** zoneArray, int count);
     ~AllocationEngine();
     
+    // Steer overflow allocations away from zones forecast to fill up
+    void setForecasters(const OccupancyForecaster* forecasterArray, int lookaheadMinutes);
+    
     // Main allocation method
     bool allocateParking(
         ParkingRequest* request,
@@ -3,49 +3,258 @@
 
 #include "ParkingRequest.h"
 #include "Zone.h"
+#include "OccupancySeries.h"
+#include "OccupancyForecaster.h"
+#include "OccupancyHeatmap.h"
+#include "QuantileSketch.h"
+#include "TopKTracker.h"
+#include "SlidingWindow.h"
+#include "RequestHistory.h"
+#include "HyperLogLog.h"
+#include "AnomalyDetector.h"
+#include "Vehicle.h"
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <deque>
+#include <functional>
 
-class Analytics {
+class JsonWriter;
+
+// Running aggregates for a single zone
+struct ZoneCounters {
+    int arrivals;         // requests ever made with this as preferred zone
+    int allocations;      // requests ever allocated to this zone
+    int completed;        // released requests
+    double revenue;       // revenue of released requests
+    double duration;      // hours of released requests
+
+    ZoneCounters();
+};
+
+// Running aggregates across all tracked requests
+struct AnalyticsCounters {
+    int totalRequests;
+    int stateCounts[REQUEST_STATE_COUNT];  // indexed by RequestState
+    int crossZoneCompleted;
+    double totalRevenue;
+    double totalDuration;
+
+    AnalyticsCounters();
+    void recordCompletion(double cost, double duration, bool crossZone);
+};
+
+// Streaming distributions of parking duration (hours) and cost
+struct UsageDistribution {
+    QuantileSketch duration;
+    QuantileSketch cost;
+
+    void merge(const UsageDistribution& other);
+};
+
+// Streaming detectors for one zone, fed by checkAnomalies
+struct ZoneAnomalyState {
+    AnomalyDetector occupancy;  // utilization, in percentage points
+    AnomalyDetector arrivals;   // arrivals per minute between checks
+    int arrivalCount;           // requests for the zone, allocated or turned away
+    int lastArrivals;
+
+    ZoneAnomalyState();
+};
+
+typedef std::function<void(const AnomalyAlert&)> AnomalyCallback;
+
+// Materialized text valid for one state version
+struct CachedText {
+    bool valid;
+    uint64_t version;
+    std::string text;
+
+    CachedText();
+};
+
+// Analytics engine. Aggregates are maintained incrementally from request
+// transitions, so every query is O(1) or O(zones). The original scan-based
+// computations are kept only to validate the running counters.
+class Analytics : public RequestObserver {
 private:
-    ParkingRequest** requests;
-    int requestCount;
+    std::vector<ParkingRequest*> requests;
     Zone** zones;
     int zoneCount;
+
+    AnalyticsCounters counters;
+    AnalyticsCounters typeCounters[VEHICLE_TYPE_COUNT];  // same aggregates split by vehicle type
+    std::unordered_map<std::string, ZoneCounters> zoneCounters;
+    std::vector<OccupancySeries> zoneSeries;  // indexed like zones
+    std::vector<OccupancyForecaster> zoneForecasters;  // indexed like zones
+    std::vector<ZoneAnomalyState> zoneAnomalies;      // indexed like zones
+    OccupancyHeatmap heatmap;                         // zones x hour-of-week
+    time_t lastCheckTime;                             // last anomaly check
+    
+    // Raised anomalies: newest last, bounded
+    std::deque<AnomalyAlert> recentAlerts;
+    AnomalyCallback alertCallback;
+    
+    UsageDistribution overallDistribution;
+    UsageDistribution typeDistributions[VEHICLE_TYPE_COUNT];
+    std::unordered_map<std::string, UsageDistribution> zoneDistributions;
     
+    // Heavy hitters, updated on allocation
+    TopKTracker zoneHitters;
+    TopKTracker vehicleHitters;
+    TopKTracker overflowHitters;  // "preferred->allocated" for cross-zone allocations
+    
+    // Distinct vehicles per zone per day, updated on allocation
+    std::unordered_map<std::string, DailyDistinctCounter> zoneVisitors;
+    
+    // Recent activity at 1-minute resolution over the last day
+    SlidingWindow activityWindow;
+    
+    // Columnar archive of released and cancelled requests
+    RequestHistory history;
+    
+    // Bumped on every tracked change; cached reports are rebuilt only when
+    // it moves past the version they were built for
+    std::atomic<uint64_t> stateVersion;
+    mutable std::mutex cacheMutex;
+    mutable CachedText cachedSummary;
+    mutable CachedText cachedReport;
+    mutable CachedText cachedReportJson;
+    mutable CachedText cachedHeatmapJson;
+    mutable CachedText cachedHeatmapBinary;
+
+    // Fold a request's current state into the counters (used when tracking starts)
+    void accumulate(const ParkingRequest& request);
+    void recordAllocation(const ParkingRequest& request);
+    void recordCompletion(const ParkingRequest& request);
+    void recordCancellation(const ParkingRequest& request);
+    const ZoneCounters* findZoneCounters(const std::string& zoneId) const;
+    int findZoneIndex(const std::string& zoneId) const;
+    void raiseAlert(int zoneIndex, const char* metric, AnomalyKind kind,
+                    double value, double expected, double score, time_t now);
+
+    // Full scans over the request history (validation only)
+    int scanStateCount(RequestState state) const;
+    double scanTotalRevenue() const;
+    double scanTotalDuration() const;
+    int scanCrossZoneAllocations() const;
+    double scanRevenueByZone(const std::string& zoneId) const;
+    int scanAllocationsByZone(const std::string& zoneId) const;
+    
+    // Report builders (uncached)
+    std::string buildSummary() const;
+    std::string buildReport() const;
+    std::string buildReportJson() const;
+    std::string buildHeatmapJson() const;
+    std::string buildHeatmapBinary() const;
+    std::string getCached(CachedText& cache, std::string (Analytics::*builder)() const) const;
+
 public:
+    // Requests in reqArray are tracked and observed by this instance; they
+    // must not transition after the Analytics object is destroyed.
     Analytics(ParkingRequest** reqArray, int reqCount, Zone** zoneArray, int zCount);
-    
+
+    // Tracking
+    void trackRequest(ParkingRequest* request);
+    void onRequestTransition(const ParkingRequest& request,
+                             RequestState previousState) override;
+    const AnalyticsCounters& getCounters() const;
+    const AnalyticsCounters& getTypeCounters(VehicleType type) const;
+    bool verifyCounters() const;
+
     // Core analytics
     double getAverageParkingDuration() const;
     double getZoneUtilizationRate(const std::string& zoneId) const;
     std::vector<double> getAllZoneUtilizationRates() const;
-    
+
     // Request statistics
+    int getTotalRequests() const;
     int getCompletedRequests() const;
     int getCancelledRequests() const;
     double getCompletionRate() const;
     double getCancellationRate() const;
+
+    // Windowed metrics ("last 15 minutes") alongside lifetime ones
+    WindowTotals getWindowTotals(int windowSeconds, time_t now) const;
+    WindowTotals getLifetimeTotals() const;
+    
+    // Distinct vehicles over the `days` days ending today (approximate,
+    // ~1.6% error); an empty zoneId counts across all zones
+    double getUniqueVehicles(const std::string& zoneId, int days, time_t now) const;
+    
+    // Historical queries over the columnar archive
+    const RequestHistory& getHistory() const;
+    
+    // Occupancy time series (bounded memory per zone); also checks anomalies
+    void sampleOccupancy(time_t now);
+    
+    // Count a parking request at entry, before allocation, so arrivals
+    // turned away by full zones still reach the arrival detector
+    void recordArrival(const std::string& zoneId);
+    // Feed the occupancy and arrival detectors. Cheap enough to run every
+    // few seconds, between the once-a-minute occupancy samples.
+    void checkAnomalies(time_t now);
+    std::vector<OccupancyBucket> getOccupancySeries(const std::string& zoneId,
+                                                    time_t from, time_t to,
+                                                    SeriesResolution resolution) const;
+    
+    // Average occupancy by zone and hour-of-week (fed by sampleOccupancy)
+    const OccupancyHeatmap& getHeatmap() const;
+    std::string getHeatmapJson() const;    // cached per state version
+    std::string getHeatmapBinary() const;  // cached per state version
+    
+    // Anomaly alerts (raised by checkAnomalies). The callback runs on the
+    // sampling thread, so it should be quick.
+    void setAlertCallback(AnomalyCallback callback);
+    std::vector<AnomalyAlert> getRecentAlerts(int maxAlerts) const;  // newest first
+    std::string getRecentAlertsJson(int maxAlerts) const;
+    void writeAlertsJson(JsonWriter& writer, int maxAlerts) const;
+    
+    // Duration and cost distributions (updated on release)
+    const UsageDistribution& getOverallDistribution() const;
+    const UsageDistribution& getTypeDistribution(VehicleType type) const;
+    const UsageDistribution* getZoneDistribution(const std::string& zoneId) const;
+    
+    // Occupancy forecasting (fed by sampleOccupancy)
+    int getPredictedFreeSlots(const std::string& zoneId, int minutesAhead, time_t now) const;
+    const OccupancyForecaster* getForecasters() const;  // indexed like zones
     
     // Peak usage
     std::string getPeakUsageZone() const;
     std::vector<std::string> getPeakUsageZones(int topN = 3) const;
-    
+    std::vector<HeavyHitter> getTopZones(int topN) const;
+    std::vector<HeavyHitter> getTopVehicles(int topN) const;
+    std::vector<HeavyHitter> getTopOverflowRoutes(int topN) const;
+
     // Revenue analytics
     double getTotalRevenue() const;
     double getAverageRevenuePerHour() const;
     double getRevenueByZone(const std::string& zoneId) const;
-    
+
     // Cross-zone statistics
     int getCrossZoneAllocations() const;
     double getCrossZoneRate() const;
-    
+
     // Display
     void displaySummary() const;
     void displayDetailedReport() const;
-    
-    // Export
+    void displayDetailedReport(int threadCount) const;  // recomputed from the archive in parallel
+
+    // Export (cached per state version)
     std::string generateReport() const;
+    std::string generateReportJson() const;
+    void writeJson(JsonWriter& writer) const;  // uncached headline report
+    
+    // State version and cache maintenance
+    uint64_t getStateVersion() const;
+    void markChanged();
+    // Rebuild the stale payloads the API serves (report and heatmap JSON)
+    // ahead of readers; the server's feed thread calls it every tick
+    void refreshCachedReports() const;
+    bool isReportJsonCurrent() const;   // report JSON cached for the current version
 };
 
-#endif
\ No newline at end of file
+#endif
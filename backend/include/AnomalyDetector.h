@@ -0,0 +1,60 @@
+#ifndef ANOMALYDETECTOR_H
+#define ANOMALYDETECTOR_H
+
+#include <ctime>
+#include <string>
+
+enum AnomalyKind {
+    ANOMALY_NONE,
+    ANOMALY_SPIKE,       // single sample far above the EWMA mean
+    ANOMALY_DROP,        // single sample far below the EWMA mean
+    ANOMALY_SHIFT_UP,    // CUSUM detected a sustained increase
+    ANOMALY_SHIFT_DOWN   // CUSUM detected a sustained decrease
+};
+
+// Alert raised for one zone metric
+struct AnomalyAlert {
+    std::string zoneId;
+    std::string metric;    // "occupancy" or "arrivals"
+    AnomalyKind kind;
+    double value;
+    double expected;
+    double score;          // z-score (spikes) or CUSUM statistic (shifts)
+    time_t timestamp;
+
+    AnomalyAlert();
+    std::string getKindString() const;
+};
+
+// Constant-memory streaming detector: EWMA mean/variance with a z-score
+// test for point anomalies, plus a two-sided CUSUM on the standardized
+// residual for change points.
+class AnomalyDetector {
+private:
+    double alpha;          // EWMA weight of the newest sample
+    double zThreshold;
+    double cusumSlack;     // k: drift allowed per sample (in std devs)
+    double cusumLimit;     // h: alarm threshold (in std devs)
+    double minStdDev;      // floor so a perfectly flat signal does not alarm on noise
+    int warmupSamples;
+
+    double mean;
+    double variance;
+    double cusumHigh;
+    double cusumLow;
+    long long count;
+
+public:
+    AnomalyDetector(double minimumStdDev = 1.0, double ewmaAlpha = 0.05,
+                    double zLimit = 4.0, double slack = 0.5, double limit = 5.0,
+                    int warmup = 10);
+
+    // Feed a sample; returns the kind of anomaly (if any) and its score
+    AnomalyKind update(double value, double& score);
+
+    double getMean() const;
+    double getStdDev() const;
+    long long getCount() const;
+};
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef HTTPSERVER_H
+#define HTTPSERVER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <sys/types.h>
+#include "AdmissionControl.h"
+#include "HttpTask.h"
+
+// Parsed HTTP/1.x request. All views point into the connection's receive
+// buffer and are only valid while the handler runs.
+struct HttpRequest {
+    std::string_view method;
+    std::string_view target;   // path plus query string
+    std::string_view path;
+    std::string_view query;    // without the leading '?'
+    std::string_view body;
+    std::vector<std::pair<std::string_view, std::string_view>> headers;
+    bool keepAlive;
+
+    HttpRequest();
+    std::string_view getHeader(std::string_view name) const;  // case-insensitive, empty if absent
+    std::string_view getQueryParam(std::string_view name) const;
+};
+
+// Response filled in by a handler. The body is one of: body (copied),
+// sharedBody (sent straight from the shared buffer) or fileFd (sent with
+// sendfile; the server closes the descriptor). A handler that calls
+// openStream() keeps the connection open as a Server-Sent Events
+// subscriber; body is sent as the first bytes of the stream.
+struct HttpResponse {
+    int status;
+    std::string contentType;
+    std::string body;
+    std::shared_ptr<const std::string> sharedBody;
+    int fileFd;
+    size_t fileLength;
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string streamChannel;   // non-empty for an event stream
+
+    HttpResponse();
+    ~HttpResponse();
+    HttpResponse(const HttpResponse&) = delete;
+    HttpResponse& operator=(const HttpResponse&) = delete;
+    size_t getContentLength() const;
+    void setHeader(const std::string& name, const std::string& value);
+    void reset();  // back to 200/JSON, keeping buffer capacity
+    void openStream(const std::string& channel);
+    bool isStream() const;
+};
+
+enum ParseResult {
+    PARSE_INCOMPLETE,
+    PARSE_COMPLETE,
+    PARSE_ERROR
+};
+
+// Incremental HTTP/1.x request parser. Call parse() each time more bytes
+// arrive; the header terminator search resumes where it left off, so a
+// request split over many reads is scanned once.
+class HttpRequestParser {
+private:
+    size_t scanned;        // bytes already searched for the header terminator
+    size_t headerLength;   // 0 until the headers are complete
+    size_t contentLength;
+    int errorStatus;
+    const char* anchor;    // buffer address the request views were parsed from
+    HttpRequest request;
+
+    bool parseHeaders(std::string_view head);
+    ParseResult fail(int status);
+
+public:
+    static const size_t MAX_HEADER_BYTES = 8 * 1024;
+    static const size_t MAX_BODY_BYTES = 1024 * 1024;
+    static const size_t MAX_HEADERS = 64;
+
+    HttpRequestParser();
+
+    // Parse the request at the start of buffer
+    ParseResult parse(std::string_view buffer);
+    void reset();
+
+    const HttpRequest& getRequest() const;
+    size_t getMessageLength() const;  // header + body bytes of a complete request
+    int getErrorStatus() const;       // status to answer with after PARSE_ERROR
+};
+
+// Pending output of one connection, in order: copied bytes, shared
+// buffers and file ranges
+class HttpOutput {
+private:
+    struct Segment {
+        std::string bytes;
+        std::shared_ptr<const std::string> shared;
+        int fd;              // file segment when >= 0
+        off_t fileOffset;
+        size_t sent;
+        size_t length;       // shared or file length
+
+        Segment();
+    };
+    std::deque<Segment> segments;
+
+public:
+    HttpOutput();
+    ~HttpOutput();
+    HttpOutput(const HttpOutput&) = delete;
+    HttpOutput& operator=(const HttpOutput&) = delete;
+
+    std::string& tail();  // bytes segment to append into
+    void appendShared(const std::shared_ptr<const std::string>& buffer);
+    void appendFile(int fd, size_t length);  // takes ownership of fd
+    // headOnly answers a HEAD request: same headers, Content-Length included, no body
+    void appendResponse(HttpResponse& response, bool keepAlive,
+                        const std::vector<std::pair<std::string, std::string>>& defaultHeaders,
+                        bool headOnly = false);
+
+    // Write as much as the socket accepts: 1 = drained, 0 = would block, -1 = error
+    int flush(int socketFd);
+    bool empty() const;
+    size_t getSegmentCount() const;
+    size_t getPendingBytes() const;   // queued and not yet sent
+};
+
+typedef std::function<void(const HttpRequest&, HttpResponse&)> HttpHandler;
+
+// Coroutine handler. The request and response stay valid across
+// suspensions: the request is copied out of the receive buffer first, and
+// the connection reads no further requests until the handler finishes.
+// Async handlers cannot open event streams.
+typedef std::function<HttpTask(const HttpRequest&, HttpResponse&)> AsyncHttpHandler;
+
+const char* getHttpStatusText(int status);
+
+struct HttpWorker;
+struct HttpConnection;
+class MetricHistogram;
+
+// Non-blocking HTTP/1.1 server for Linux. One thread accepts connections
+// and hands them round-robin to workerCount epoll loops; each connection
+// stays on its worker for its whole keep-alive lifetime. In thread-per-core
+// mode there is no acceptor thread: every worker owns a SO_REUSEPORT
+// listening socket, the kernel spreads connections across them, and each
+// worker is pinned to its own CPU. Handlers run on worker threads, so
+// shared state must be synchronized by the caller.
+//
+// Admission control: each pass of a worker loop queues complete requests
+// in a read lane and a write lane (by method), serves reads first, and
+// answers 503 with Retry-After instead of running a handler when a lane is
+// full or a request waited too long. Per-client token buckets answer 429.
+// They are shared by the workers behind striped locks, except in
+// thread-per-core mode, where each worker keeps buckets for the connections
+// the kernel gave it (a client spread over several connections may then get
+// up to one budget per worker).
+//
+// Every route has a latency histogram in the process-wide metrics registry
+// (unrouted requests share route="other"), and responses, admission
+// decisions, connections and streams are counted there too.
+//
+// Asynchronous routes return an HttpTask. A handler that co_awaits
+// offload(...) gives its worker back while the blocking pool runs the
+// work; the coroutine is then resumed on the same worker, so short
+// requests are not held up behind a slow report.
+class HttpServer {
+private:
+    struct Route {
+        HttpHandler handler;
+        AsyncHttpHandler asyncHandler;
+        MetricHistogram* latency;
+    };
+
+    int port;
+    int workerCount;
+    int listenFd;
+    int stopFd;            // eventfd that wakes the accept loop
+    std::atomic<bool> running;
+    int idleTimeoutSeconds;
+    std::atomic<int> streamCount;
+    bool threadPerCore;
+    AdmissionConfig admission;
+    ClientRateLimiter rateLimiter;
+
+    std::unordered_map<std::string, Route> routes;  // "METHOD path"
+    HttpHandler fallback;
+    MetricHistogram* fallbackLatency;
+    std::vector<std::pair<std::string, std::string>> defaultHeaders;
+    std::vector<std::unique_ptr<HttpWorker>> workers;
+    std::atomic<int> suspendedCount;
+
+    // Blocking pool for offloaded work
+    int offloadThreadCount;
+    std::vector<std::thread> offloadThreads;
+    std::mutex offloadMutex;
+    std::condition_variable offloadReady;
+    std::deque<std::function<void()>> offloadJobs;
+    bool offloadStopping;
+
+    void acceptLoop();
+    void offloadLoop();
+    void stopOffloadPool();
+    const Route* findRoute(const HttpRequest& request) const;
+    void dispatchRoute(const Route* route, const HttpRequest& request, HttpResponse& response,
+                       HttpOutput& out) const;
+    void workerLoop(HttpWorker& worker);
+    void scheduleNext(HttpWorker& worker, HttpConnection& conn);
+    void shed(HttpConnection& conn, int status, int retryAfterSeconds);
+    void processQueues(HttpWorker& worker);
+    void beginAsync(HttpWorker& worker, HttpConnection& conn, const Route& route);
+    void resumeAsync(HttpWorker& worker, HttpConnection& conn, std::coroutine_handle<> handle);
+    void finishAsync(HttpWorker& worker, HttpConnection& conn);
+
+public:
+    HttpServer(int listenPort, int workers);
+    ~HttpServer();
+
+    // Configuration (before start)
+    void route(const std::string& method, const std::string& path, HttpHandler handler);
+    void routeAsync(const std::string& method, const std::string& path, AsyncHttpHandler handler);
+    void setFallback(HttpHandler handler);
+    void addDefaultHeader(const std::string& name, const std::string& value);
+    void setIdleTimeout(int seconds);
+    void setThreadPerCore(bool enabled);
+    void setAdmission(const AdmissionConfig& config);
+    void setOffloadThreads(int count);
+
+    // Bind and listen; port 0 picks an ephemeral port
+    bool start();
+    // Serve until stop() is called (blocks the calling thread)
+    void run();
+    // Safe to call from a signal handler
+    void stop();
+
+    int getPort() const;
+    int getWorkerCount() const;
+    bool isThreadPerCore() const;
+    const AdmissionConfig& getAdmission() const;
+    AdmissionStats getAdmissionStats() const;
+
+    // Reads (GET, HEAD, OPTIONS) are served before writes
+    static RequestPriority classify(const HttpRequest& request);
+    int getStreamCount() const;   // open event-stream connections
+    int getSuspendedCount() const;   // async handlers waiting on offloaded work
+
+    // Run job on the blocking pool. Safe from any thread.
+    void offload(std::function<void()> job);
+
+    // Queue an event for every stream subscribed to channel. Safe from any
+    // thread; the bytes are shared, not copied, across subscribers.
+    void publish(const std::string& channel, const std::string& event);
+
+    // Route a parsed request and serialize the response into out. The
+    // response object is reset, not reallocated, so a connection can reuse
+    // its body buffer across requests. Async routes are started by the
+    // worker loop; here they answer 500.
+    void dispatch(const HttpRequest& request, HttpResponse& response, HttpOutput& out) const;
+};
+
+#endif
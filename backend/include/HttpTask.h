@@ -0,0 +1,115 @@
+#ifndef HTTPTASK_H
+#define HTTPTASK_H
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Coroutine returned by an asynchronous route handler. The frame starts
+// suspended; the server resumes it on the connection's worker thread and
+// sends the response once it finishes. An exception escaping the handler
+// is kept and turned into a 500.
+class HttpTask {
+public:
+    struct promise_type {
+        std::exception_ptr error;
+
+        HttpTask get_return_object() {
+            return HttpTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+public:
+    HttpTask();
+    explicit HttpTask(std::coroutine_handle<promise_type> frame);
+    ~HttpTask();
+    HttpTask(HttpTask&& other) noexcept;
+    HttpTask& operator=(HttpTask&& other) noexcept;
+    HttpTask(const HttpTask&) = delete;
+    HttpTask& operator=(const HttpTask&) = delete;
+
+    explicit operator bool() const;   // holds a coroutine frame
+    bool done() const;
+    std::coroutine_handle<> getHandle() const;
+    void rethrow() const;             // rethrow the handler's exception, if any
+};
+
+// Hand job to the server's blocking pool and resume `resume` on the
+// calling worker once it has run (implemented by HttpServer). Outside an
+// asynchronous handler the job runs inline and this returns false, so the
+// awaiting coroutine continues without suspending.
+bool submitOffload(std::function<void()> job, std::coroutine_handle<> resume);
+
+// Awaitable that runs blocking work (fsync, a long report, a large route
+// query) off the I/O thread and yields its result
+template <typename Result>
+class OffloadAwaiter {
+private:
+    std::function<Result()> work;
+    std::optional<Result> result;
+    std::exception_ptr error;
+
+public:
+    explicit OffloadAwaiter(std::function<Result()> fn) : work(std::move(fn)) {}
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        return submitOffload([this]() {
+            try {
+                result.emplace(work());
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }, handle);
+    }
+    Result await_resume() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*result);
+    }
+};
+
+// OffloadAwaiter for work without a result
+template <>
+class OffloadAwaiter<void> {
+private:
+    std::function<void()> work;
+    std::exception_ptr error;
+
+public:
+    explicit OffloadAwaiter(std::function<void()> fn) : work(std::move(fn)) {}
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        return submitOffload([this]() {
+            try {
+                work();
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }, handle);
+    }
+    void await_resume() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+// co_await offload(fn): run fn on the blocking pool, resume on this worker.
+// GCC 12 destroys a closure with non-trivial captures (a std::string, say)
+// wrongly when it is created inside the co_await expression; bind such a
+// lambda to a local first and pass that.
+template <typename Fn>
+OffloadAwaiter<std::invoke_result_t<Fn&>> offload(Fn&& fn) {
+    return OffloadAwaiter<std::invoke_result_t<Fn&>>(std::function<std::invoke_result_t<Fn&>()>(std::forward<Fn>(fn)));
+}
+
+#endif
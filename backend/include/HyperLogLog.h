@@ -0,0 +1,51 @@
+#ifndef HYPERLOGLOG_H
+#define HYPERLOGLOG_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// HyperLogLog distinct counter. 2^PRECISION one-byte registers (4 KB)
+// give a standard error of about 1.6% regardless of how many keys are
+// added; sketches merge by taking the register-wise maximum.
+class HyperLogLog {
+public:
+    static const int PRECISION = 12;
+    static const int REGISTER_COUNT = 1 << PRECISION;
+
+private:
+    std::vector<uint8_t> registers;
+
+public:
+    HyperLogLog();
+
+    static uint64_t hashKey(const std::string& key);
+
+    void add(const std::string& key);
+    void addHash(uint64_t hash);
+    void merge(const HyperLogLog& other);
+    void clear();
+    double estimate() const;
+};
+
+// Ring of daily HyperLogLog sketches covering the last `days` days.
+// Queries over several days merge the daily sketches on the fly.
+class DailyDistinctCounter {
+private:
+    std::vector<HyperLogLog> sketches;
+    std::vector<time_t> dayStarts;  // -1 when unused
+
+public:
+    static const int SECONDS_PER_DAY = 24 * 60 * 60;
+
+    DailyDistinctCounter(int days = 14);
+
+    void add(time_t timestamp, const std::string& key);
+
+    // Merge the sketches for the `days` days ending with the day of `now`
+    void mergeInto(HyperLogLog& target, time_t now, int days) const;
+    int getRetentionDays() const;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <charconv>
+
+// Streaming JSON writer that appends straight into a caller-owned buffer.
+// Commas and key separators are tracked by nesting depth, strings are
+// escaped per RFC 8259, and numbers go through std::to_chars (integer
+// fast path, shortest round-trip doubles), so nothing is allocated beyond
+// the buffer's own growth. Reuse one buffer per connection to keep its
+// capacity between responses. Nesting deeper than MAX_DEPTH, or closing
+// more than was opened, marks the writer failed: its output is not valid
+// JSON.
+class JsonWriter {
+public:
+    static const int MAX_DEPTH = 32;
+
+private:
+    std::string& out;
+    bool hasElement[MAX_DEPTH];  // per level: a value was already written
+    int depth;
+    int excessDepth;      // levels opened past MAX_DEPTH (not tracked)
+    bool afterKey;
+    bool failed;
+
+    void separate();
+    JsonWriter& open(char bracket);
+    JsonWriter& close(char bracket);
+
+public:
+    explicit JsonWriter(std::string& buffer);
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text);
+    JsonWriter& value(const std::string& text);
+    JsonWriter& value(bool flag);
+    JsonWriter& value(double number);                 // shortest round-trip
+    JsonWriter& value(double number, int precision);  // fixed decimals
+    JsonWriter& null();
+    JsonWriter& raw(std::string_view json);           // already-serialized value
+
+    // Integers of any width
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                            JsonWriter&>::type
+    value(T number) {
+        separate();
+        char digits[24];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+        out.append(digits, result.ptr);
+        return *this;
+    }
+
+    // key(name).value(v) in one call
+    template <typename T>
+    JsonWriter& field(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+    JsonWriter& field(std::string_view name, double number, int precision);
+
+    int getDepth() const;
+    bool hasFailed() const;   // nesting overflowed or was unbalanced
+
+    // Append text as a quoted, escaped JSON string
+    static void appendString(std::string& buffer, std::string_view text);
+};
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Counters and histograms are split into shards on separate cache lines;
+// each thread is given one shard, so a hot metric never bounces a line
+// between cores and recording is a single uncontended relaxed add.
+// Reading a metric sums the shards.
+const int METRIC_SHARDS = 16;
+
+int assignMetricShard();
+
+// Shard index of the calling thread
+inline int metricShard() {
+    thread_local int shard = assignMetricShard();
+    return shard;
+}
+
+// Monotonically increasing count
+class MetricCounter {
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> value;
+    };
+    Slot slots[METRIC_SHARDS];
+
+public:
+    MetricCounter();
+
+    // Add to the calling thread's shard
+    void increment(uint64_t amount = 1) {
+        slots[metricShard()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+    uint64_t getValue() const;
+};
+
+// Value that can go up and down
+class MetricGauge {
+private:
+    std::atomic<int64_t> value;
+
+public:
+    MetricGauge();
+
+    void set(int64_t newValue) { value.store(newValue, std::memory_order_relaxed); }
+    void add(int64_t delta) { value.fetch_add(delta, std::memory_order_relaxed); }
+    int64_t getValue() const;
+};
+
+// Latency histogram with fixed power-of-4 buckets from 1.024us to 4.29s
+// (upper bounds 2^10 * 4^k nanoseconds) plus +Inf. The bucket of a sample
+// comes from its bit length, so recording has no search or division.
+class MetricHistogram {
+public:
+    static const int BUCKETS = 13;   // 12 finite bounds and +Inf
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> counts[BUCKETS];
+        std::atomic<uint64_t> sumNanos;
+    };
+    Shard shards[METRIC_SHARDS];
+
+public:
+    MetricHistogram();
+
+    // Bucket index of a duration in nanoseconds
+    static int bucketFor(uint64_t nanos) {
+        if (nanos <= 1024) return 0;
+        int bits = 64 - __builtin_clzll(nanos - 1);   // ceil(log2(nanos))
+        int bucket = (bits - 9) / 2;
+        return bucket < BUCKETS - 1 ? bucket : BUCKETS - 1;
+    }
+    static uint64_t getUpperBoundNanos(int bucket);   // 0 for +Inf
+
+    void record(uint64_t nanos) {
+        Shard& shard = shards[metricShard()];
+        shard.counts[bucketFor(nanos)].fetch_add(1, std::memory_order_relaxed);
+        shard.sumNanos.fetch_add(nanos, std::memory_order_relaxed);
+    }
+
+    uint64_t getBucketCount(int bucket) const;   // not cumulative
+    uint64_t getCount() const;
+    uint64_t getSumNanos() const;
+};
+
+// Times a scope into a histogram
+class ScopedTimer {
+private:
+    MetricHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(MetricHistogram& target)
+        : histogram(target), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        histogram.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+// Named metrics in Prometheus families. Registration takes a lock and
+// returns a reference that stays valid for the life of the registry, so
+// callers look a metric up once (typically into a function-local static)
+// and record without touching the registry again.
+class MetricsRegistry {
+private:
+    enum MetricType {
+        METRIC_COUNTER,
+        METRIC_GAUGE,
+        METRIC_HISTOGRAM
+    };
+
+    struct Series {
+        std::string labels;   // rendered, e.g. route="GET /api/zones"
+        std::unique_ptr<MetricCounter> counter;
+        std::unique_ptr<MetricGauge> gauge;
+        std::unique_ptr<MetricHistogram> histogram;
+    };
+
+    struct Family {
+        std::string name;
+        std::string help;
+        MetricType type;
+        std::vector<std::unique_ptr<Series>> series;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Family>> families;
+
+    Series& findOrAdd(const std::string& name, const std::string& help, MetricType type,
+                      const std::string& labels);
+
+public:
+    MetricsRegistry();
+
+    MetricCounter& counter(const std::string& name, const std::string& help,
+                           const std::string& labels = "");
+    MetricGauge& gauge(const std::string& name, const std::string& help,
+                       const std::string& labels = "");
+    MetricHistogram& histogram(const std::string& name, const std::string& help,
+                               const std::string& labels = "");
+
+    // Prometheus text exposition format 0.0.4
+    void writePrometheus(std::string& out) const;
+    size_t getFamilyCount() const;
+
+    // Render name="value" with Prometheus escaping
+    static std::string label(const std::string& name, const std::string& value);
+};
+
+// Process-wide registry
+MetricsRegistry& metrics();
+
+#endif
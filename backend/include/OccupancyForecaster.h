@@ -0,0 +1,44 @@
+#ifndef OCCUPANCYFORECASTER_H
+#define OCCUPANCYFORECASTER_H
+
+#include <ctime>
+
+// Online Holt-Winters forecaster (additive level, trend and daily
+// seasonality) for one zone's occupancy fraction. Each sample costs O(1)
+// and the state is a fixed array of seasonal offsets.
+class OccupancyForecaster {
+public:
+    static const int SEASON_SLOTS = 96;                 // 15-minute slots per day
+    static const int SLOT_SECONDS = 24 * 60 * 60 / SEASON_SLOTS;
+
+private:
+    double alpha;   // level smoothing
+    double beta;    // trend smoothing
+    double gamma;   // seasonal smoothing
+    double phi;     // trend damping per minute
+
+    double level;   // de-seasonalized occupancy fraction
+    double trend;   // change in level per minute
+    double seasonal[SEASON_SLOTS];
+    bool initialized;
+    time_t lastUpdate;
+    long long sampleCount;
+
+    static int slotFor(time_t timestamp);
+
+public:
+    OccupancyForecaster(double levelAlpha = 0.3, double trendBeta = 0.05,
+                        double seasonGamma = 0.1, double trendDamping = 0.98);
+
+    // occupancy is a fraction in [0, 1]
+    void update(time_t timestamp, double occupancy);
+
+    // Predicted occupancy fraction minutesAhead after now
+    double forecast(time_t now, int minutesAhead) const;
+    int forecastFreeSlots(int totalSlots, time_t now, int minutesAhead) const;
+
+    bool isReady() const;   // enough samples to trust the forecast
+    long long getSampleCount() const;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef OCCUPANCYHEATMAP_H
+#define OCCUPANCYHEATMAP_H
+
+#include <ctime>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Average occupancy by zone and hour-of-week (UTC, Monday 00:00 = hour 0).
+// Running sums and counts live in one contiguous zones x 168 matrix, so a
+// sample is O(1) and serialization never touches the request history.
+class OccupancyHeatmap {
+public:
+    static const int HOURS_PER_WEEK = 168;
+
+private:
+    std::vector<std::string> zoneIds;
+    std::vector<double> sums;       // [zone * HOURS_PER_WEEK + hour]
+    std::vector<uint32_t> counts;
+
+public:
+    explicit OccupancyHeatmap(const std::vector<std::string>& zones);
+
+    static int hourOfWeek(time_t timestamp);
+
+    void addSample(int zoneIndex, time_t timestamp, double occupancy);
+    double getAverage(int zoneIndex, int hour) const;  // -1 when no samples
+    uint32_t getCount(int zoneIndex, int hour) const;
+    int getZoneCount() const;
+
+    // {"hours":168,"zones":[{"zoneId":"ZA","average":[12.5,null,...]}]}
+    std::string toJson() const;
+    // Little-endian: "NPHM", u16 format version, u16 zone count, u16 hours;
+    // per zone u8 id length + id bytes; then zones x hours u16 cells holding
+    // average occupancy in basis points (0..10000), 0xFFFF = no samples
+    std::string toBinary() const;
+};
+
+#endif
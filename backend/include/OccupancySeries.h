@@ -0,0 +1,61 @@
+#ifndef OCCUPANCYSERIES_H
+#define OCCUPANCYSERIES_H
+
+#include <ctime>
+#include <vector>
+
+// Aggregated occupancy samples for one time bucket
+struct OccupancyBucket {
+    time_t start;     // bucket start time, -1 when the slot is unused
+    int samples;
+    double sum;
+    double min;
+    double max;
+
+    OccupancyBucket();
+    double getAverage() const;
+};
+
+// Fixed-capacity ring of buckets at a single resolution. Old buckets are
+// overwritten in place, so memory never grows.
+class OccupancyRing {
+private:
+    std::vector<OccupancyBucket> buckets;
+    int bucketSeconds;
+    time_t newestStart;  // start of the most recent bucket written
+
+public:
+    OccupancyRing(int secondsPerBucket, int capacity);
+
+    void add(time_t timestamp, double value);
+    std::vector<OccupancyBucket> query(time_t from, time_t to) const;
+
+    int getBucketSeconds() const;
+    int getCapacity() const;
+};
+
+enum SeriesResolution {
+    RESOLUTION_MINUTE,
+    RESOLUTION_15_MINUTES,
+    RESOLUTION_HOUR
+};
+
+// Per-zone occupancy time series. Each sample is folded into the 1-minute,
+// 15-minute and hourly rings at once, which keeps the roll-ups current.
+class OccupancySeries {
+private:
+    OccupancyRing minuteRing;    // last 24 hours
+    OccupancyRing quarterRing;   // last 7 days
+    OccupancyRing hourRing;      // last 90 days
+
+    const OccupancyRing& ringFor(SeriesResolution resolution) const;
+
+public:
+    OccupancySeries();
+
+    void recordSample(time_t timestamp, double occupancy);
+    std::vector<OccupancyBucket> query(time_t from, time_t to,
+                                       SeriesResolution resolution) const;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef PARKINGREQUEST_H
 #define PARKINGREQUEST_H
 
+#include "Vehicle.h"
 #include <string>
 #include <ctime>
 
@@ -12,6 +13,19 @@ enum RequestState {
     CANCELLED
 };
 
+const int REQUEST_STATE_COUNT = CANCELLED + 1;
+
+class ParkingRequest;
+class JsonWriter;
+
+// Observer notified after every successful state transition
+class RequestObserver {
+public:
+    virtual ~RequestObserver() {}
+    virtual void onRequestTransition(const ParkingRequest& request,
+                                     RequestState previousState) = 0;
+};
+
 class ParkingRequest {
 private:
     std::string requestId;
@@ -24,13 +38,18 @@ private:
     time_t allocationTime;
     time_t completionTime;
     int durationHours;
+    VehicleType vehicleType;
     double totalCost;
     bool isCrossZone;
+    RequestObserver* observer;
+    
+    void notifyTransition(RequestState previousState);
     
 public:
     ParkingRequest(const std::string& reqId, 
                   const std::string& vehicle, 
-                  const std::string& zone);
+                  const std::string& zone,
+                  VehicleType type = CAR);
     
     // State transitions (STRICT state machine)
     bool allocate(const std::string& zone, const std::string& slot, 
@@ -42,6 +61,13 @@ public:
     // State validation
     bool isValidTransition(RequestState newState) const;
     
+    // Booking details (set by the allocator before allocation)
+    void setDurationHours(int hours);
+    
+    // Observer (not owned, may be nullptr)
+    void setObserver(RequestObserver* obs);
+    RequestObserver* getObserver() const;
+    
     // Getters
     std::string getRequestId() const;
     std::string getVehicleId() const;
@@ -54,12 +80,14 @@ public:
     time_t getAllocationTime() const;
     time_t getCompletionTime() const;
     double getDuration() const;  // in hours
+    VehicleType getVehicleType() const;
     double getTotalCost() const;
     bool getIsCrossZone() const;
     
     // Display
     std::string toString() const;
     std::string getDetailedInfo() const;
+    void writeJson(JsonWriter& writer) const;
 };
 
 #endif
\ No newline at end of file
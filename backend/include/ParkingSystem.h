@@ -7,8 +7,13 @@
 #include "AllocationEngine.h"
 #include "RollbackManager.h"
 #include "Analytics.h"
+#include "ZoneStatusBuffer.h"
+#include "RequestParser.h"
 #include <vector>
 #include <string>
+#include <string_view>
+#include <ctime>
+#include <map>
 
 class ParkingSystem {
 private:
@@ -19,14 +24,22 @@ private:
     std::vector<Vehicle*> vehicles;
     std::vector<ParkingRequest*> requests;
     
+    // Id lookups; std::less<> lets them be probed with a string_view
+    std::map<std::string, Zone*, std::less<>> zoneIndex;
+    std::map<std::string, Vehicle*, std::less<>> vehicleIndex;
+    std::map<std::string, ParkingRequest*, std::less<>> requestIndex;
+    int nextRequestNumber;
+    
     AllocationEngine* allocator;
     RollbackManager* rollbackManager;
     Analytics* analytics;
+    AnomalyCallback alertCallback;  // re-attached whenever analytics is rebuilt
+    ZoneStatusBuffer* zoneStatus;   // live zone list JSON, patched on slot changes
     
     // Helper methods
-    Vehicle* findVehicle(const std::string& vehicleId) const;
-    ParkingRequest* findRequest(const std::string& requestId) const;
-    Zone* findZone(const std::string& zoneId) const;
+    Vehicle* findVehicle(std::string_view vehicleId) const;
+    ParkingRequest* findRequest(std::string_view requestId) const;
+    Zone* findZone(std::string_view zoneId) const;
     
 public:
     ParkingSystem();
@@ -38,13 +51,20 @@ public:
     void addVehicle(Vehicle* vehicle);
     
     // Core operations
-    std::string requestParking(const std::string& vehicleId, 
-                              const std::string& preferredZone,
-                              int durationHours);
+    // Unknown vehicles are registered as cars; returns "" when the zone is
+    // unknown or nothing is available
+    std::string requestParking(std::string_view vehicleId,
+                               std::string_view preferredZone,
+                               int durationHours);
+    
+    // Lifecycle steps; false for unknown ids or invalid transitions
+    bool cancelParking(std::string_view requestId);
+    bool occupyParking(std::string_view requestId);
+    bool releaseParking(std::string_view requestId);
     
-    bool cancelParking(const std::string& requestId);
-    bool occupyParking(const std::string& requestId);
-    bool releaseParking(const std::string& requestId);
+    // Apply parsed batch items in order, writing one result object per item
+    // into a JSON array; returns the number that succeeded
+    int executeBatch(const std::vector<BatchOperation>& operations, JsonWriter& writer);
     
     // Rollback operations
     bool undoLastOperation();
@@ -54,6 +74,25 @@ public:
     void displayAnalytics() const;
     void displayZoneStatus() const;
     void displayAllRequests() const;
+    void recordOccupancySample();
+    void recordOccupancySample(time_t now);
+    void checkAnomalies();   // between samples, to catch surges within seconds
+    uint64_t getStateVersion() const;
+    std::string getAnalyticsJson() const;
+    void refreshAnalytics() const;   // rebuild stale cached API payloads
+    void setAlertCallback(AnomalyCallback callback);
+    std::string getAlertsJson(int maxAlerts) const;
+    std::string getHeatmapJson() const;
+    const std::string& getZonesJson() const;  // valid until the next slot change
+    int takeZoneDeltas(std::string& out);     // zones changed since the last call
+    // {"version","full","zones"}: deltas for zones changed after `since`, or
+    // the full list when the client is too far behind to make a delta worthwhile
+    void writeZonesSince(JsonWriter& writer, uint64_t since) const;
+    uint64_t getZoneVersion() const;
+    
+    // Lookups
+    bool hasZone(std::string_view zoneId) const;
+    const ParkingRequest* getRequest(std::string_view requestId) const;
     
     // Utility
     int getTotalAvailableSlots() const;
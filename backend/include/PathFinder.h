@@ -32,6 +32,7 @@ public:
     void push(PathNode* node);
     PathNode* pop();
     bool isEmpty() const;
+    void clear();
     void updateDistance(const std::string& zoneId, int newDistance, const std::string& previous);
 };
 
@@ -0,0 +1,45 @@
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <cstdint>
+
+// Fixed-memory streaming quantile sketch (log-bucketed histogram in the
+// spirit of HDR histograms). Values are mapped to buckets whose width grows
+// geometrically, bounding the relative error of every quantile to about 1%.
+// Sketches with the same layout merge by adding bucket counts, so partial
+// sketches from different periods or shards combine without the raw data.
+class QuantileSketch {
+public:
+    static const int BUCKET_COUNT = 1200;
+    static const double RELATIVE_ACCURACY;
+    static const double MIN_TRACKED_VALUE;  // smaller values land in the zero bucket
+
+private:
+    uint64_t counts[BUCKET_COUNT];
+    uint64_t zeroCount;
+    uint64_t totalCount;
+    double sum;
+    double minValue;
+    double maxValue;
+
+    static int bucketIndex(double value);
+    static double bucketValue(int index);
+
+public:
+    QuantileSketch();
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+    void clear();
+
+    // q in [0, 1]; walks a fixed number of buckets regardless of sample count
+    double quantile(double q) const;
+
+    uint64_t getCount() const;
+    double getSum() const;
+    double getMean() const;
+    double getMin() const;
+    double getMax() const;
+};
+
+#endif
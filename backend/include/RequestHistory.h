@@ -0,0 +1,86 @@
+#ifndef REQUESTHISTORY_H
+#define REQUESTHISTORY_H
+
+#include "ParkingRequest.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Aggregates computed over a request history
+struct HistoryAggregates {
+    long long stateCounts[REQUEST_STATE_COUNT];
+    long long crossZoneCompleted;
+    double revenue;               // released requests only
+    double duration;              // released requests only
+    std::vector<double> revenueByZone;  // indexed by zone handle
+
+    HistoryAggregates();
+    void merge(const HistoryAggregates& other);
+};
+
+// Columnar archive of finished requests. Each field lives in its own
+// contiguous array so aggregation kernels stream only the columns they
+// need; the hot kernels have an AVX2 path selected at runtime with a
+// scalar fallback.
+class RequestHistory {
+private:
+    std::vector<uint8_t> states;
+    std::vector<double> costs;
+    std::vector<double> durations;
+    std::vector<uint16_t> zoneHandles;
+    std::vector<uint8_t> crossZoneFlags;
+    std::vector<int64_t> requestTimes;
+    std::vector<int64_t> allocationTimes;
+    std::vector<int64_t> completionTimes;
+
+    // Zone dictionary: handle <-> zone ID
+    std::vector<std::string> zoneNames;
+    std::unordered_map<std::string, uint16_t> zoneHandleById;
+
+    static bool avx2Enabled;
+
+public:
+    RequestHistory();
+
+    uint16_t internZone(const std::string& zoneId);
+    void append(const ParkingRequest& request);
+    void reserve(size_t count);
+    void clear();
+
+    size_t size() const;
+    int getZoneCount() const;
+    std::string getZoneId(uint16_t handle) const;
+    int findZoneHandle(const std::string& zoneId) const;  // -1 if unknown
+
+    // Column access (for custom kernels)
+    const uint8_t* getStates() const;
+    const double* getCosts() const;
+    const double* getDurations() const;
+    const uint16_t* getZoneHandles() const;
+    const uint8_t* getCrossZoneFlags() const;
+    const int64_t* getRequestTimes() const;
+    const int64_t* getAllocationTimes() const;
+    const int64_t* getCompletionTimes() const;
+
+    // Kernels over rows [begin, end)
+    long long countState(RequestState state, size_t begin, size_t end) const;
+    double sumCost(RequestState state, size_t begin, size_t end) const;
+    double sumDuration(RequestState state, size_t begin, size_t end) const;
+    long long countCrossZoneCompleted(size_t begin, size_t end) const;
+    void addRevenueByZone(std::vector<double>& totals, size_t begin, size_t end) const;
+
+    HistoryAggregates aggregate(size_t begin, size_t end) const;
+    HistoryAggregates aggregate() const;
+
+    // Partition rows across worker threads and merge their partial
+    // aggregates (threadCount <= 0 uses all hardware threads)
+    HistoryAggregates aggregateParallel(int threadCount) const;
+
+    // SIMD control (disabling forces the scalar kernels)
+    static bool isAvx2Supported();
+    static void setAvx2Enabled(bool enabled);
+    static bool isAvx2Enabled();
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef REQUESTPARSER_H
+#define REQUESTPARSER_H
+
+#include <string_view>
+#include <vector>
+
+// Fields of a /api/request-parking body. The views point into the request
+// body and are only valid while it is.
+struct ParkingRequestBody {
+    std::string_view vehicleId;
+    std::string_view preferredZone;
+    int durationHours;
+
+    ParkingRequestBody();
+};
+
+const int MAX_ID_LENGTH = 32;
+const int MAX_DURATION_HOURS = 24;
+const int MAX_BATCH_OPERATIONS = 100;
+
+enum BatchOpType {
+    BATCH_REQUEST,
+    BATCH_OCCUPY,
+    BATCH_RELEASE,
+    BATCH_CANCEL,
+    BATCH_INVALID   // well-formed JSON that failed validation; see error
+};
+
+// One item of a /api/batch body. Views point into the request body.
+struct BatchOperation {
+    BatchOpType type;
+    std::string_view opName;
+    std::string_view vehicleId;      // request
+    std::string_view preferredZone;  // request
+    int durationHours;               // request
+    std::string_view requestId;      // occupy, release, cancel
+    std::string_view error;
+
+    BatchOperation();
+};
+
+// Parse {"vehicleId":"...","preferredZone":"...","durationHours":n} in
+// place, without building a DOM or copying strings. Keys may appear in any
+// order and unknown keys are skipped. Ids must be 1-32 characters of
+// [A-Za-z0-9_-] (so they never need unescaping) and the duration must be
+// an integer from 1 to 24. On failure, error names the problem.
+bool parseParkingRequestBody(std::string_view body, ParkingRequestBody& out,
+                             std::string_view& error);
+
+// Parse {"operations":[...]} (or a bare array) of objects such as
+// {"op":"request","vehicleId":"V1","preferredZone":"ZA","durationHours":2}
+// and {"op":"occupy"|"release"|"cancel","requestId":"REQ001"}. An item that
+// fails validation becomes BATCH_INVALID so the rest of the batch still
+// runs; malformed JSON or more than MAX_BATCH_OPERATIONS items fails the
+// whole body.
+bool parseBatchBody(std::string_view body, std::vector<BatchOperation>& out,
+                    std::string_view& error);
+
+// Check an id against the allowed character set and length
+bool isValidId(std::string_view id);
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef SLIDINGWINDOW_H
+#define SLIDINGWINDOW_H
+
+#include <ctime>
+#include <vector>
+
+// Common window lengths in seconds
+enum AnalyticsWindow {
+    WINDOW_5_MINUTES = 5 * 60,
+    WINDOW_15_MINUTES = 15 * 60,
+    WINDOW_HOUR = 60 * 60,
+    WINDOW_DAY = 24 * 60 * 60
+};
+
+// Request activity totals over some period, with the derived rates
+// mirroring the lifetime metrics in Analytics
+struct WindowTotals {
+    int requests;
+    int allocations;
+    int completed;
+    int cancelled;
+    int crossZoneCompleted;
+    double revenue;
+    double duration;
+
+    WindowTotals();
+    void add(const WindowTotals& other);
+
+    double getCompletionRate() const;
+    double getCancellationRate() const;
+    double getCrossZoneRate() const;
+    double getAverageDuration() const;
+    double getAverageRevenuePerHour() const;
+};
+
+// Bucketed sliding window over the last day at 1-minute resolution.
+// Events older than the ring are dropped; memory is fixed.
+class SlidingWindow {
+private:
+    struct Bucket {
+        time_t start;  // -1 when unused
+        WindowTotals totals;
+    };
+
+    std::vector<Bucket> buckets;
+    int bucketSeconds;
+    time_t newestStart;
+
+    WindowTotals* bucketFor(time_t timestamp);
+
+public:
+    SlidingWindow(int secondsPerBucket = 60, int capacity = 24 * 60);
+
+    void recordRequest(time_t timestamp);
+    void recordAllocation(time_t timestamp);
+    void recordCompletion(time_t timestamp, double revenue, double duration, bool crossZone);
+    void recordCancellation(time_t timestamp);
+
+    // Sum of buckets overlapping (now - windowSeconds, now]
+    WindowTotals getTotals(time_t now, int windowSeconds) const;
+    int getMaxWindowSeconds() const;
+};
+
+#endif
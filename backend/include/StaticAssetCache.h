@@ -0,0 +1,71 @@
+#ifndef STATICASSETCACHE_H
+#define STATICASSETCACHE_H
+
+#include "HttpServer.h"
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+// One frontend file. Small files are held in memory with precompressed
+// variants; larger ones are only described and streamed with sendfile.
+struct StaticAsset {
+    std::string filePath;
+    std::string contentType;
+    std::string etag;       // strong validator, quoted
+    size_t size;
+    bool inMemory;
+    std::shared_ptr<const std::string> identity;
+    std::shared_ptr<const std::string> gzip;     // null when not smaller
+    std::shared_ptr<const std::string> brotli;   // null when not smaller or unavailable
+
+    StaticAsset();
+};
+
+// In-memory cache of a frontend directory. Assets are loaded and
+// compressed once, then swapped in as an immutable table, so readers never
+// wait on a reload. An inotify watcher rebuilds the table when files change.
+class StaticAssetCache {
+public:
+    typedef std::unordered_map<std::string, std::shared_ptr<const StaticAsset>> AssetTable;
+
+private:
+    std::string rootDir;
+    size_t maxCachedFileBytes;
+
+    mutable std::mutex tableMutex;
+    std::shared_ptr<const AssetTable> table;   // keyed by URL path ("/index.html")
+    std::atomic<uint64_t> generation;
+
+    std::thread watcher;
+    int stopFd;
+
+    void loadDirectory(const std::string& dir, const std::string& urlPrefix, AssetTable& into) const;
+    std::shared_ptr<const StaticAsset> loadFile(const std::string& filePath) const;
+    void watchLoop();
+
+public:
+    StaticAssetCache(const std::string& directory, size_t maxInMemoryBytes = 1024 * 1024);
+    ~StaticAssetCache();
+
+    // Load (or reload) every file under the directory
+    void reload();
+    // Reload automatically on changes (Linux inotify)
+    bool startWatching();
+    void stopWatching();
+
+    // Fill the response for a GET; returns false if no such asset. "/" maps to /index.html.
+    bool serve(const HttpRequest& request, HttpResponse& response) const;
+
+    std::shared_ptr<const StaticAsset> find(const std::string& urlPath) const;
+    size_t getAssetCount() const;
+    uint64_t getGeneration() const;  // bumped on every reload
+
+    static std::string contentTypeFor(const std::string& path);
+    static bool isCompressible(const std::string& contentType);
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef TOPKTRACKER_H
+#define TOPKTRACKER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Tracked key with its estimated count. The true count lies in
+// [count - error, count].
+struct HeavyHitter {
+    std::string key;
+    long long count;
+    long long error;
+
+    HeavyHitter(const std::string& k = "", long long c = 0, long long e = 0);
+};
+
+// Space-saving heavy-hitter tracker with a fixed number of counters.
+// Counts are exact while fewer than `capacity` distinct keys have been
+// seen; afterwards the smallest counter is recycled for new keys.
+class TopKTracker {
+private:
+    std::vector<HeavyHitter> entries;
+    std::unordered_map<std::string, int> slotByKey;
+    int capacity;
+
+    int findMinSlot() const;
+
+public:
+    TopKTracker(int maxKeys = 32);
+
+    void offer(const std::string& key, long long weight = 1);
+    std::vector<HeavyHitter> top(int n) const;
+    long long estimate(const std::string& key) const;
+
+    int getCapacity() const;
+    int getSize() const;
+    void clear();
+};
+
+#endif
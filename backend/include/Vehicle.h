@@ -3,12 +3,29 @@
 
 #include <string>
 
+// Vehicle type configuration: X(enum id, display name, pricing multiplier).
+// Adding a row here extends the enum, the lookup table and every per-type
+// analytics array; nothing else needs to change.
+#define NEXUSPARK_VEHICLE_TYPES(X) \
+    X(CAR,   "CAR",   1.0)         \
+    X(BIKE,  "BIKE",  0.5)         \
+    X(TRUCK, "TRUCK", 2.0)
+
 enum VehicleType {
-    CAR,
-    BIKE,
-    TRUCK
+#define NEXUSPARK_VEHICLE_ENUM(id, name, multiplier) id,
+    NEXUSPARK_VEHICLE_TYPES(NEXUSPARK_VEHICLE_ENUM)
+#undef NEXUSPARK_VEHICLE_ENUM
+    VEHICLE_TYPE_COUNT
+};
+
+// Static description of a vehicle type
+struct VehicleTypeInfo {
+    const char* name;
+    double multiplier;
 };
 
+const VehicleTypeInfo& getVehicleTypeInfo(VehicleType type);
+
 class Vehicle {
 private:
     std::string vehicleId;
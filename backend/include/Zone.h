@@ -3,6 +3,7 @@
 
 #include "ParkingArea.h"
 #include <string>
+#include <cstdint>
 
 // Custom adjacency list node for zone connections (Graph structure)
 struct ZoneConnection {
@@ -14,6 +15,16 @@ struct ZoneConnection {
     ZoneConnection(const std::string& zoneId, int dist, double penalty = 1.5);
 };
 
+class Zone;
+class JsonWriter;
+
+// Notified after a zone's availability changes
+class ZoneObserver {
+public:
+    virtual ~ZoneObserver() {}
+    virtual void onZoneChanged(const Zone& zone) = 0;
+};
+
 class Zone {
 private:
     std::string zoneId;
@@ -29,6 +40,9 @@ private:
     // Custom adjacency list for zone connections (Graph)
     ZoneConnection* connections;
     
+    ZoneObserver* observer;
+    uint64_t version;   // value of the global change counter at the last change
+    
 public:
     Zone(const std::string& id, const std::string& name, int slots, double rate);
     ~Zone();
@@ -48,6 +62,15 @@ public:
     bool allocateSlot();
     bool releaseSlot();
     
+    // Availability change notification
+    void setObserver(ZoneObserver* zoneObserver);
+    ZoneObserver* getObserver() const;
+    
+    // Change versions: every availability change on any zone takes the next
+    // value of one process-wide counter
+    uint64_t getVersion() const;
+    static uint64_t getCurrentVersion();
+    
     // Getters
     std::string getZoneId() const;
     std::string getZoneName() const;
@@ -59,6 +82,7 @@ public:
     // Display
     std::string toString() const;
     std::string getConnectionsString() const;
+    void writeJson(JsonWriter& writer) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef ZONESTATUSBUFFER_H
+#define ZONESTATUSBUFFER_H
+
+#include "Zone.h"
+#include "JsonWriter.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Byte range of a value patched in place
+struct PatchField {
+    size_t offset;
+    int width;
+};
+
+// Pre-serialized JSON array of all zones. Availability and utilization are
+// written into fixed-width, space-padded fields (valid JSON whitespace), so
+// a slot change rewrites a few bytes instead of re-serializing the list.
+// Changed zones are also queued, once each, until takeChanges() drains
+// them, so a burst of slot changes collapses into one delta per zone.
+// Not synchronized: patches and reads must happen under the same lock.
+// The zones must outlive the buffer; its destructor detaches itself from
+// each zone's observer slot.
+class ZoneStatusBuffer : public ZoneObserver {
+private:
+    std::string json;
+    std::vector<const Zone*> zones;
+    std::vector<PatchField> availableFields;    // indexed like zones
+    std::vector<PatchField> utilizationFields;
+    std::unordered_map<const Zone*, int> zoneIndex;
+    std::vector<int> changedZones;             // drain order
+    std::vector<char> changedFlags;            // indexed like zones
+
+    void writeField(const PatchField& field, const char* text, int length);
+    void patch(int index);
+
+public:
+    // Serializes the zones and registers as each zone's observer
+    ZoneStatusBuffer(Zone** zoneArray, int zoneCount);
+    ~ZoneStatusBuffer();
+
+    void onZoneChanged(const Zone& zone) override;
+
+    const std::string& getJson() const;
+
+    // Append changed zones as a JSON array of availability deltas and clear
+    // the queue; returns the number of zones written
+    int takeChanges(std::string& out);
+    int getPendingChangeCount() const;
+
+    // Availability delta for one zone: {"zoneId","availableSlots","utilization"}
+    static void writeDelta(JsonWriter& writer, const Zone& zone);
+};
+
+#endif
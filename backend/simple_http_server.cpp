@@ -1,197 +1,338 @@
 ﻿#include "../include/ParkingSystem.h"
+#include "../include/HttpServer.h"
+#include "../include/JsonWriter.h"
+#include "../include/RequestParser.h"
+#include "../include/StaticAssetCache.h"
+#include "../include/Metrics.h"
 #include <iostream>
 #include <memory>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <vector>
-#include <winsock2.h>
-#include <windows.h>
-
-#pragma comment(lib, "ws2_32.lib")
+#include <mutex>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <atomic>
+#include <chrono>
+#include <charconv>
 
 using namespace std;
 
 unique_ptr<ParkingSystem> parkingSystem;
 
-// Helper to create JSON
-string jsonResponse(bool success, const string& message, const string& data = "{}") {
-    stringstream ss;
-    ss << R"({"success":)" << (success ? "true" : "false") 
-       << R"(,"message":")" << message << R"(")";
-    if (!data.empty() && data != "{}") {
-        ss << R"(,"data":)" << data;
+// ParkingSystem is not thread-safe; every handler touching it holds this
+mutex systemMutex;
+
+HttpServer* activeServer = nullptr;
+
+// Per-client request budget; kiosks behind one NAT address share it
+const double CLIENT_RATE_PER_SECOND = 50.0;
+const double CLIENT_BURST = 100.0;
+
+// Per-thread copy of the zone list. The hot GET path only reads the zone
+// version counter; the lock is taken just to refresh after a slot change.
+struct ZoneListCache {
+    uint64_t version;
+    string json;
+    
+    ZoneListCache() : version(0) {}
+};
+thread_local ZoneListCache zoneListCache;
+
+// Get the zone list JSON for this thread, refreshing it if stale
+const string& currentZonesJson() {
+    if (zoneListCache.json.empty() || zoneListCache.version != Zone::getCurrentVersion()) {
+        lock_guard<mutex> lock(systemMutex);
+        zoneListCache.version = parkingSystem->getZoneVersion();
+        zoneListCache.json = parkingSystem->getZonesJson();
     }
-    ss << "}";
-    return ss.str();
+    return zoneListCache.json;
 }
 
-// HTTP response builder
-string buildHttpResponse(int status, const string& content, const string& contentType = "application/json") {
-    stringstream response;
-    response << "HTTP/1.1 " << status << " OK\r\n"
-             << "Content-Type: " << contentType << "\r\n"
-             << "Access-Control-Allow-Origin: *\r\n"
-             << "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n"
-             << "Access-Control-Allow-Headers: Content-Type\r\n"
-             << "Content-Length: " << content.length() << "\r\n"
-             << "Connection: close\r\n\r\n"
-             << content;
-    return response.str();
+// Zone deltas are coalesced and pushed to /api/zones/stream once per tick
+const int DELTA_TICK_MS = 250;
+const int HEARTBEAT_TICKS = 60;   // comment line every 15s keeps proxies from timing out
+const int SAMPLE_TICKS = 240;     // occupancy sample once a minute, the series resolution
+const int ANOMALY_TICKS = 20;     // anomaly check every 5s, so surges alert within seconds
+atomic<bool> deltaFeedRunning(false);
+
+// Write the {"success","message","data"} envelope into the response body.
+// The body keeps its capacity across requests on the same connection.
+JsonWriter beginEnvelope(HttpResponse& res, int status, bool success, const string& message) {
+    res.status = status;
+    res.contentType = "application/json";
+    JsonWriter writer(res.body);
+    writer.beginObject().field("success", success).field("message", message);
+    return writer;
 }
 
-// Serve frontend files
-string serveFrontend() {
-    FILE* file = fopen("../frontend/index.html", "rb");
-    if (!file) {
-        return buildHttpResponse(404, "Frontend not found", "text/plain");
+// Fill a JSON response whose data (if any) is already serialized
+void sendJson(HttpResponse& res, int status, bool success, const string& message,
+              string_view data = string_view()) {
+    JsonWriter writer = beginEnvelope(res, status, success, message);
+    if (!data.empty()) {
+        writer.key("data").raw(data);
     }
+    writer.endObject();
+}
+
+// Frontend files, loaded and compressed once at startup
+StaticAssetCache frontendAssets("../frontend");
+
+// Register API routes
+void registerRoutes(HttpServer& server) {
+    // Zone list is pre-serialized and patched in place; each thread serves its own copy.
+    // With ?since=<version> only zones changed after that version are sent.
+    server.route("GET", "/api/zones", [](const HttpRequest& req, HttpResponse& res) {
+        string_view sinceParam = req.getQueryParam("since");
+        if (sinceParam.empty()) {
+            sendJson(res, 200, true, "Zones retrieved", currentZonesJson());
+            return;
+        }
+        uint64_t since = 0;
+        from_chars_result parsed = from_chars(sinceParam.data(), sinceParam.data() + sinceParam.size(), since);
+        if (parsed.ec != errc() || parsed.ptr != sinceParam.data() + sinceParam.size()) {
+            sendJson(res, 400, false, "Invalid since version");
+            return;
+        }
+        JsonWriter writer = beginEnvelope(res, 200, true, "Zones retrieved");
+        writer.key("data");
+        lock_guard<mutex> lock(systemMutex);
+        parkingSystem->writeZonesSince(writer, since);
+        writer.endObject();
+    });
+    
+    // Server-Sent Events: a full snapshot, then availability deltas. Event ids
+    // are zone versions, usable with /api/zones?since= after a disconnect.
+    server.route("GET", "/api/zones/stream", [](const HttpRequest&, HttpResponse& res) {
+        res.openStream("zones");
+        res.body = "retry: 2000\nevent: snapshot\nid: ";
+        lock_guard<mutex> lock(systemMutex);
+        res.body += to_string(parkingSystem->getZoneVersion());
+        res.body += "\ndata: ";
+        res.body += parkingSystem->getZonesJson();
+        res.body += "\n\n";
+    });
+    
+    // Body fields are parsed as views into the receive buffer
+    server.route("POST", "/api/request-parking", [](const HttpRequest& req, HttpResponse& res) {
+        ParkingRequestBody fields;
+        string_view error;
+        if (!parseParkingRequestBody(req.body, fields, error)) {
+            sendJson(res, 400, false, string(error));
+            return;
+        }
+        
+        lock_guard<mutex> lock(systemMutex);
+        if (!parkingSystem->hasZone(fields.preferredZone)) {
+            sendJson(res, 400, false, "Unknown zone");
+            return;
+        }
+        string requestId = parkingSystem->requestParking(fields.vehicleId, fields.preferredZone,
+                                                         fields.durationHours);
+        if (requestId.empty()) {
+            sendJson(res, 200, false, "No parking available");
+            return;
+        }
+        JsonWriter writer = beginEnvelope(res, 200, true, "Parking allocated");
+        writer.key("data");
+        parkingSystem->getRequest(requestId)->writeJson(writer);
+        writer.endObject();
+    });
+    
+    // Many operations in one round trip: parsed outside the lock, applied under it once
+    server.route("POST", "/api/batch", [](const HttpRequest& req, HttpResponse& res) {
+        thread_local vector<BatchOperation> operations;
+        string_view error;
+        if (!parseBatchBody(req.body, operations, error)) {
+            sendJson(res, 400, false, string(error));
+            return;
+        }
+        
+        JsonWriter writer = beginEnvelope(res, 200, true, "Batch applied");
+        writer.key("data").beginObject().key("results");
+        int succeeded;
+        {
+            lock_guard<mutex> lock(systemMutex);
+            succeeded = parkingSystem->executeBatch(operations, writer);
+        }
+        writer.field("succeeded", succeeded)
+              .field("failed", static_cast<int>(operations.size()) - succeeded)
+              .endObject()
+              .endObject();
+    });
+    
+    // Admission counters: how much load is being turned away, by lane
+    server.route("GET", "/api/server-stats", [](const HttpRequest&, HttpResponse& res) {
+        AdmissionStats stats = activeServer->getAdmissionStats();
+        JsonWriter writer = beginEnvelope(res, 200, true, "Server statistics");
+        writer.key("data").beginObject()
+              .field("workers", activeServer->getWorkerCount())
+              .field("streams", activeServer->getStreamCount());
+        writer.key("admitted").beginObject()
+              .field("read", stats.admitted[PRIORITY_READ])
+              .field("write", stats.admitted[PRIORITY_WRITE])
+              .endObject();
+        writer.key("shed").beginObject()
+              .field("queueFullRead", stats.shedQueueFull[PRIORITY_READ])
+              .field("queueFullWrite", stats.shedQueueFull[PRIORITY_WRITE])
+              .field("queueDelayRead", stats.shedQueueDelay[PRIORITY_READ])
+              .field("queueDelayWrite", stats.shedQueueDelay[PRIORITY_WRITE])
+              .field("rateLimited", stats.rateLimited)
+              .field("total", stats.getShedTotal())
+              .endObject();
+        writer.endObject().endObject();
+    });
+    
+    // Prometheus scrape endpoint: route latencies, allocation, path finding,
+    // rollback and admission counters
+    server.route("GET", "/metrics", [](const HttpRequest&, HttpResponse& res) {
+        res.contentType = "text/plain; version=0.0.4";
+        metrics().writePrometheus(res.body);
+    });
+    
+    // Reports are built on the blocking pool; the worker keeps serving
+    // /api/zones and other short requests in the meantime
+    server.routeAsync("GET", "/api/analytics", [](const HttpRequest&, HttpResponse& res) -> HttpTask {
+        string report = co_await offload([]() {
+            lock_guard<mutex> lock(systemMutex);
+            return parkingSystem->getAnalyticsJson();
+        });
+        sendJson(res, 200, true, "Analytics data", report);
+    });
     
-    fseek(file, 0, SEEK_END);
-    long size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    server.route("GET", "/api/alerts", [](const HttpRequest&, HttpResponse& res) {
+        lock_guard<mutex> lock(systemMutex);
+        sendJson(res, 200, true, "Recent alerts", parkingSystem->getAlertsJson(50));
+    });
     
-    vector<char> buffer(size + 1);
-    fread(buffer.data(), 1, size, file);
-    fclose(file);
-    buffer[size] = 0;
+    server.routeAsync("GET", "/api/heatmap", [](const HttpRequest&, HttpResponse& res) -> HttpTask {
+        string heatmap = co_await offload([]() {
+            lock_guard<mutex> lock(systemMutex);
+            return parkingSystem->getHeatmapJson();
+        });
+        sendJson(res, 200, true, "Occupancy heatmap", heatmap);
+    });
     
-    return buildHttpResponse(200, string(buffer.data()), "text/html");
+    // CORS preflight, frontend assets and unknown paths
+    server.setFallback([](const HttpRequest& req, HttpResponse& res) {
+        if (req.method == "OPTIONS") {
+            res.status = 204;
+            res.contentType = "text/plain";
+            return;
+        }
+        if (req.path.substr(0, 5) == "/api/") {
+            sendJson(res, 404, false, "Endpoint not found");
+            return;
+        }
+        if ((req.method == "GET" || req.method == "HEAD") && frontendAssets.serve(req, res)) {
+            return;
+        }
+        res.status = 404;
+        res.contentType = "text/plain";
+        res.body = "Not Found";
+    });
 }
 
-// Handle API requests
-string handleApiRequest(const string& method, const string& path, const string& body) {
-    cout << "API Request: " << method << " " << path << endl;
-    
-    if (method == "GET" && path == "/api/zones") {
-        string zonesJson = R"([
-            {"zoneId":"ZA","totalSlots":20,"availableSlots":12,"hourlyRate":10},
-            {"zoneId":"ZB","totalSlots":15,"availableSlots":8,"hourlyRate":12},
-            {"zoneId":"ZC","totalSlots":25,"availableSlots":5,"hourlyRate":8},
-            {"zoneId":"ZD","totalSlots":30,"availableSlots":20,"hourlyRate":15},
-            {"zoneId":"ZE","totalSlots":18,"availableSlots":10,"hourlyRate":11}
-        ])";
-        return buildHttpResponse(200, jsonResponse(true, "Zones retrieved", zonesJson));
-    }
-    
-    if (method == "POST" && path == "/api/request-parking") {
-        string response = R"({
-            "requestId": "REQ001",
-            "allocatedZone": "ZA",
-            "slotNumber": 5,
-            "totalCost": 30.0
-        })";
-        return buildHttpResponse(200, jsonResponse(true, "Parking allocated", response));
+// Publish coalesced zone changes to stream subscribers each tick, sample
+// occupancy for analytics, alerts, the heatmap and forecasts, and rebuild
+// stale analytics payloads so /api/analytics and /api/heatmap hit the cache
+void runDeltaFeed(HttpServer& server) {
+    string event;
+    int idleTicks = 0;
+    int sampleTicks = SAMPLE_TICKS;   // first sample on the first tick
+    int anomalyTicks = 0;
+    while (deltaFeedRunning) {
+        this_thread::sleep_for(chrono::milliseconds(DELTA_TICK_MS));
+        event = "event: zones\nid: ";
+        int changed;
+        {
+            lock_guard<mutex> lock(systemMutex);
+            if (++sampleTicks >= SAMPLE_TICKS) {
+                parkingSystem->recordOccupancySample();   // checks anomalies too
+                sampleTicks = 0;
+                anomalyTicks = 0;
+            } else if (++anomalyTicks >= ANOMALY_TICKS) {
+                parkingSystem->checkAnomalies();
+                anomalyTicks = 0;
+            }
+            parkingSystem->refreshAnalytics();
+            event += to_string(parkingSystem->getZoneVersion());
+            event += "\ndata: ";
+            changed = parkingSystem->takeZoneDeltas(event);
+        }
+        if (changed > 0) {
+            event += "\n\n";
+            server.publish("zones", event);
+            idleTicks = 0;
+        } else if (++idleTicks >= HEARTBEAT_TICKS) {
+            server.publish("zones", ": keep-alive\n\n");
+            idleTicks = 0;
+        }
     }
-    
-    if (method == "GET" && path == "/api/analytics") {
-        string analytics = R"({
-            "totalRequests": 50,
-            "successfulRequests": 40,
-            "completionRate": 80.0,
-            "totalRevenue": 450.0
-        })";
-        return buildHttpResponse(200, jsonResponse(true, "Analytics data", analytics));
+}
+
+// Stop the server on Ctrl+C
+void handleSignal(int) {
+    if (activeServer) {
+        activeServer->stop();
     }
-    
-    return buildHttpResponse(404, jsonResponse(false, "Endpoint not found"));
 }
 
-int main() {
-    cout << "🚀 Starting NexusPark HTTP Server on port 5000..." << endl;
-    cout << "Frontend: http://localhost:5000" << endl;
-    cout << "APIs: /api/zones, /api/request-parking, /api/analytics" << endl;
+// Usage: simple_http_server [port] [workers] [--thread-per-core]
+int main(int argc, char* argv[]) {
+    int port = argc > 1 ? atoi(argv[1]) : 5000;
+    int workers = argc > 2 ? atoi(argv[2]) : static_cast<int>(thread::hardware_concurrency());
+    if (workers <= 0) workers = 1;
+    bool threadPerCore = argc > 3 && string(argv[3]) == "--thread-per-core";
+    
+    cout << "🚀 Starting NexusPark HTTP Server on port " << port << "..." << endl;
+    cout << "Frontend: http://localhost:" << port << endl;
+    cout << "APIs: /api/zones, /api/request-parking, /api/analytics, /api/alerts, /api/heatmap, /api/zones/stream, /api/batch, /api/server-stats, /metrics" << endl;
     
     // Initialize parking system
     parkingSystem = make_unique<ParkingSystem>();
     parkingSystem->initializeZones();
     cout << "✅ Parking system initialized with 5 zones." << endl;
     
-    // Initialize Winsock
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-        cerr << "❌ Failed to initialize Winsock" << endl;
-        return 1;
-    }
+    frontendAssets.reload();
+    frontendAssets.startWatching();
+    cout << "✅ Cached " << frontendAssets.getAssetCount() << " frontend asset(s)." << endl;
     
-    // Create socket
-    SOCKET serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-    if (serverSocket == INVALID_SOCKET) {
-        cerr << "❌ Failed to create socket" << endl;
-        WSACleanup();
-        return 1;
-    }
+    HttpServer server(port, workers);
+    server.setThreadPerCore(threadPerCore);
+    AdmissionConfig admission;
+    admission.clientRate = CLIENT_RATE_PER_SECOND;
+    admission.clientBurst = CLIENT_BURST;
+    server.setAdmission(admission);
+    server.addDefaultHeader("Access-Control-Allow-Origin", "*");
+    server.addDefaultHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
+    server.addDefaultHeader("Access-Control-Allow-Headers", "Content-Type");
+    registerRoutes(server);
     
-    // Bind to port 5000
-    sockaddr_in serverAddr;
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_addr.s_addr = INADDR_ANY;
-    serverAddr.sin_port = htons(5000);
-    
-    if (bind(serverSocket, (sockaddr*)&serverAddr, sizeof(serverAddr)) == SOCKET_ERROR) {
-        cerr << "❌ Failed to bind to port 5000. Error: " << WSAGetLastError() << endl;
-        closesocket(serverSocket);
-        WSACleanup();
+    if (!server.start()) {
+        cerr << "❌ Failed to bind to port " << port << endl;
         return 1;
     }
     
-    // Listen for connections
-    if (listen(serverSocket, 10) == SOCKET_ERROR) {
-        cerr << "❌ Failed to listen" << endl;
-        closesocket(serverSocket);
-        WSACleanup();
-        return 1;
-    }
+    activeServer = &server;
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
     
-    cout << "✅ Server running on http://localhost:5000" << endl;
+    cout << "✅ Server running on http://localhost:" << server.getPort()
+         << " with " << server.getWorkerCount() << " worker(s)"
+         << (server.isThreadPerCore() ? ", one listener per core" : "") << endl;
     cout << "Press Ctrl+C to stop" << endl;
     
-    // Main server loop
-    while (true) {
-        sockaddr_in clientAddr;
-        int clientAddrLen = sizeof(clientAddr);
-        SOCKET clientSocket = accept(serverSocket, (sockaddr*)&clientAddr, &clientAddrLen);
-        
-        if (clientSocket == INVALID_SOCKET) {
-            cerr << "Failed to accept connection" << endl;
-            continue;
-        }
-        
-        char buffer[4096];
-        int bytesReceived = recv(clientSocket, buffer, sizeof(buffer), 0);
-        if (bytesReceived > 0) {
-            buffer[bytesReceived] = '\0';
-            string request(buffer);
-            
-            string method, path;
-            stringstream requestStream(request);
-            requestStream >> method >> path;
-            
-            string body;
-            if (method == "POST") {
-                size_t bodyPos = request.find("\r\n\r\n");
-                if (bodyPos != string::npos) {
-                    body = request.substr(bodyPos + 4);
-                }
-            }
-            
-            string response;
-            if (path == "/" || path == "/index.html") {
-                response = serveFrontend();
-            }
-            else if (path.find("/api/") == 0) {
-                response = handleApiRequest(method, path, body);
-            }
-            else {
-                response = buildHttpResponse(404, "Not Found", "text/plain");
-            }
-            
-            send(clientSocket, response.c_str(), response.length(), 0);
-        }
-        
-        closesocket(clientSocket);
-    }
+    deltaFeedRunning = true;
+    thread deltaFeed(runDeltaFeed, ref(server));
     
-    closesocket(serverSocket);
-    WSACleanup();
+    server.run();
+    deltaFeedRunning = false;
+    deltaFeed.join();
+    activeServer = nullptr;
+    frontendAssets.stopWatching();
     return 0;
 }
@@ -0,0 +1,149 @@
+#include "../include/AdmissionControl.h"
+#include <chrono>
+
+// AdmissionConfig constructor: generous bounds, no rate limit
+AdmissionConfig::AdmissionConfig()
+    : clientRate(0.0), clientBurst(0.0), retryAfterSeconds(1) {
+    maxQueued[PRIORITY_READ] = 1024;
+    maxQueued[PRIORITY_WRITE] = 256;
+    maxQueueDelayMs[PRIORITY_READ] = 1000;
+    maxQueueDelayMs[PRIORITY_WRITE] = 250;
+}
+
+// AdmissionStats constructor
+AdmissionStats::AdmissionStats() : rateLimited(0) {
+    for (int i = 0; i < PRIORITY_COUNT; i++) {
+        admitted[i] = 0;
+        shedQueueFull[i] = 0;
+        shedQueueDelay[i] = 0;
+    }
+}
+
+// Total requests turned away
+uint64_t AdmissionStats::getShedTotal() const {
+    uint64_t total = rateLimited;
+    for (int i = 0; i < PRIORITY_COUNT; i++) {
+        total += shedQueueFull[i] + shedQueueDelay[i];
+    }
+    return total;
+}
+
+// TokenBucket constructor (starts full on first use)
+TokenBucket::TokenBucket() : tokens(-1.0), lastRefill(0.0) {}
+
+// Refill for elapsed time and take one token
+bool TokenBucket::take(double rate, double burst, double now, double& retryAfter) {
+    if (tokens < 0.0) {
+        tokens = burst;
+    } else {
+        tokens += (now - lastRefill) * rate;
+        if (tokens > burst) tokens = burst;
+    }
+    lastRefill = now;
+
+    if (tokens >= 1.0) {
+        tokens -= 1.0;
+        retryAfter = 0.0;
+        return true;
+    }
+    retryAfter = (1.0 - tokens) / rate;
+    return false;
+}
+
+// Check whether the bucket has refilled completely
+bool TokenBucket::isFull(double rate, double burst, double now) const {
+    return tokens < 0.0 || tokens + (now - lastRefill) * rate >= burst;
+}
+
+// LocalRateLimiter constructor
+LocalRateLimiter::LocalRateLimiter() : rate(0.0), burst(0.0) {}
+
+// Set the per-client rate (0 disables limiting)
+void LocalRateLimiter::configure(double requestsPerSecond, double burstSize) {
+    rate = requestsPerSecond > 0.0 ? requestsPerSecond : 0.0;
+    burst = burstSize >= 1.0 ? burstSize : 1.0;
+}
+
+// Check whether limiting is on
+bool LocalRateLimiter::isEnabled() const {
+    return rate > 0.0;
+}
+
+// Charge one request to a client
+bool LocalRateLimiter::allow(uint32_t client, double now, double& retryAfter) {
+    if (rate <= 0.0) {
+        retryAfter = 0.0;
+        return true;
+    }
+    return buckets[client].take(rate, burst, now, retryAfter);
+}
+
+// Drop buckets that have refilled
+void LocalRateLimiter::sweep(double now) {
+    if (rate <= 0.0) return;
+    for (auto it = buckets.begin(); it != buckets.end();) {
+        if (it->second.isFull(rate, burst, now)) {
+            it = buckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// Get number of tracked clients
+size_t LocalRateLimiter::getClientCount() const {
+    return buckets.size();
+}
+
+// ClientRateLimiter constructor
+ClientRateLimiter::ClientRateLimiter() : rate(0.0), burst(0.0) {}
+
+// Set the per-client rate (0 disables limiting)
+void ClientRateLimiter::configure(double requestsPerSecond, double burstSize) {
+    rate = requestsPerSecond > 0.0 ? requestsPerSecond : 0.0;
+    burst = burstSize >= 1.0 ? burstSize : 1.0;
+    for (Stripe& stripe : stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        stripe.buckets.configure(rate, burst);
+    }
+}
+
+// Check whether limiting is on
+bool ClientRateLimiter::isEnabled() const {
+    return rate > 0.0;
+}
+
+// Charge one request to a client
+bool ClientRateLimiter::allow(uint32_t client, double now, double& retryAfter) {
+    if (rate <= 0.0) {
+        retryAfter = 0.0;
+        return true;
+    }
+    Stripe& stripe = stripes[(client * 2654435761u) >> 28];
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    return stripe.buckets.allow(client, now, retryAfter);
+}
+
+// Drop buckets that have refilled
+void ClientRateLimiter::sweep(double now) {
+    if (rate <= 0.0) return;
+    for (Stripe& stripe : stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        stripe.buckets.sweep(now);
+    }
+}
+
+// Get number of tracked clients
+size_t ClientRateLimiter::getClientCount() {
+    size_t count = 0;
+    for (Stripe& stripe : stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        count += stripe.buckets.getClientCount();
+    }
+    return count;
+}
+
+// Seconds on the monotonic clock
+double monotonicSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -1,12 +1,14 @@
 ﻿#include "../include/AllocationEngine.h"
+#include "../include/Metrics.h"
 #include <iostream>
 #include <iomanip>
 #include <limits>
 #include <algorithm>
+#include <ctime>
 
 // AllocationEngine constructor
 AllocationEngine::AllocationEngine(Zone** zoneArray, int count)
-    : zones(zoneArray), zoneCount(count) {
+    : zones(zoneArray), zoneCount(count), forecasters(nullptr), forecastMinutes(0) {
     pathFinder = new PathFinder(count);
 }
 
@@ -15,6 +17,21 @@ AllocationEngine::~AllocationEngine() {
     delete pathFinder;
 }
 
+// Set occupancy forecasters used to steer overflow allocations
+void AllocationEngine::setForecasters(const OccupancyForecaster* forecasterArray, int lookaheadMinutes) {
+    forecasters = forecasterArray;
+    forecastMinutes = lookaheadMinutes;
+}
+
+// Check if a zone is forecast to be full within the lookahead window
+bool AllocationEngine::isPredictedFull(int zoneIndex) const {
+    if (!forecasters || !forecasters[zoneIndex].isReady()) return false;
+    
+    int freeSlots = forecasters[zoneIndex].forecastFreeSlots(
+        zones[zoneIndex]->getTotalSlots(), time(nullptr), forecastMinutes);
+    return freeSlots <= 0;
+}
+
 // Find available slot in specific zone
 std::string AllocationEngine::findAvailableSlotInZone(const std::string& zoneId) {
     for (int i = 0; i < zoneCount; i++) {
@@ -72,7 +89,18 @@ bool AllocationEngine::allocateParking(
     std::vector<std::string>& optimalPath,
     double& totalCost
 ) {
+    static MetricHistogram& latency = metrics().histogram(
+        "nexuspark_allocation_duration_seconds", "Time spent in AllocationEngine::allocateParking");
+    static MetricCounter& preferred = metrics().counter(
+        "nexuspark_allocations_total", "Allocation attempts by outcome", MetricsRegistry::label("result", "preferred"));
+    static MetricCounter& crossZone = metrics().counter(
+        "nexuspark_allocations_total", "Allocation attempts by outcome", MetricsRegistry::label("result", "cross_zone"));
+    static MetricCounter& failed = metrics().counter(
+        "nexuspark_allocations_total", "Allocation attempts by outcome", MetricsRegistry::label("result", "failed"));
+    ScopedTimer timer(latency);
+
     std::string preferredZone = request->getPreferredZone();
+    request->setDurationHours(durationHours);
     
     // Step 1: Try to allocate in preferred zone
     allocatedSlot = findAvailableSlotInZone(preferredZone);
@@ -82,7 +110,9 @@ bool AllocationEngine::allocateParking(
         totalCost = calculateCost(preferredZone, durationHours, false, vehicle);
         
         // Update request
-        return request->allocate(allocatedZone, allocatedSlot, totalCost, false);
+        bool allocated = request->allocate(allocatedZone, allocatedSlot, totalCost, false);
+        (allocated ? preferred : failed).increment();
+        return allocated;
     }
     
     // Step 2: Preferred zone is full, find nearest available zone
@@ -93,48 +123,68 @@ bool AllocationEngine::allocateParking(
             totalCost = calculateCost(allocatedZone, durationHours, true, vehicle);
             
             // Update request
-            return request->allocate(allocatedZone, allocatedSlot, totalCost, true);
+            bool allocated = request->allocate(allocatedZone, allocatedSlot, totalCost, true);
+            (allocated ? crossZone : failed).increment();
+            return allocated;
         }
     }
     
     // Step 3: No zones available
+    failed.increment();
     return false;
 }
 
-// Find nearest zone with available slots
+// Find the zone with available slots nearest the preferred zone by road.
+// Zones forecast to fill up are skipped on the first pass and only used if
+// nothing else is available.
 std::string AllocationEngine::findNearestAvailableZone(
     const std::string& preferredZone,
     std::vector<std::string>& path
 ) {
     std::string nearestZone;
-    int minDistance = std::numeric_limits<int>::max();
-    
-    // Check all zones
+    Zone* startZone = nullptr;
     for (int i = 0; i < zoneCount; i++) {
-        std::string zoneId = zones[i]->getZoneId();
-        
-        // Skip preferred zone (already checked and full)
-        if (zoneId == preferredZone) continue;
+        if (zones[i]->getZoneId() == preferredZone) {
+            startZone = zones[i];
+            break;
+        }
+    }
+    if (!startZone) return nearestZone;
+    
+    for (int pass = 0; pass < 2 && nearestZone.empty(); pass++) {
+        bool avoidFilling = (pass == 0);
+        int minDistance = std::numeric_limits<int>::max();
         
-        // Check if zone has available slots
-        if (zones[i]->getAvailableSlots() > 0) {
-            // Find shortest path to this zone
-            std::vector<std::string> currentPath = 
-                pathFinder->findShortestPath(
-                    zones[0], // Start from first zone (simplified)
-                    zones[i], 
-                    zones, 
-                    zoneCount
-                );
+        // Check all zones
+        for (int i = 0; i < zoneCount; i++) {
+            std::string zoneId = zones[i]->getZoneId();
             
-            // Calculate total distance
-            int distance = pathFinder->calculateDistance(currentPath, zones, zoneCount);
+            // Skip preferred zone (already checked and full)
+            if (zoneId == preferredZone) continue;
             
-            // Update nearest zone if this one is closer
-            if (distance < minDistance && distance > 0) {
-                minDistance = distance;
-                nearestZone = zoneId;
-                path = currentPath;
+            // Check if zone has available slots
+            if (zones[i]->getAvailableSlots() > 0) {
+                if (avoidFilling && isPredictedFull(i)) continue;
+                
+                // Find shortest path to this zone (empty when unreachable)
+                std::vector<std::string> currentPath = 
+                    pathFinder->findShortestPath(
+                        startZone,
+                        zones[i], 
+                        zones, 
+                        zoneCount
+                    );
+                if (currentPath.empty()) continue;
+                
+                // Calculate total distance
+                int distance = pathFinder->calculateDistance(currentPath, zones, zoneCount);
+                
+                // Update nearest zone if this one is closer
+                if (distance < minDistance) {
+                    minDistance = distance;
+                    nearestZone = zoneId;
+                    path = currentPath;
+                }
             }
         }
     }
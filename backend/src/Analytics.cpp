@@ -1,31 +1,313 @@
 ﻿#include "../include/Analytics.h"
+#include "../include/JsonWriter.h"
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <cmath>
 #include <algorithm>
 #include <map>
 #include <vector>
 #include <utility>
 
+// ZoneCounters constructor
+ZoneCounters::ZoneCounters()
+    : arrivals(0), allocations(0), completed(0), revenue(0.0), duration(0.0) {}
+
+// AnalyticsCounters constructor
+AnalyticsCounters::AnalyticsCounters()
+    : totalRequests(0), crossZoneCompleted(0), totalRevenue(0.0), totalDuration(0.0) {
+    for (int i = 0; i < REQUEST_STATE_COUNT; i++) {
+        stateCounts[i] = 0;
+    }
+}
+
+// Merge another distribution into this one
+void UsageDistribution::merge(const UsageDistribution& other) {
+    duration.merge(other.duration);
+    cost.merge(other.cost);
+}
+
+// Fold a released request into the counters
+void AnalyticsCounters::recordCompletion(double cost, double duration, bool crossZone) {
+    totalRevenue += cost;
+    totalDuration += duration;
+    if (crossZone) {
+        crossZoneCompleted++;
+    }
+}
+
+// ZoneAnomalyState constructor
+ZoneAnomalyState::ZoneAnomalyState()
+    : occupancy(2.0), arrivals(0.5), arrivalCount(0), lastArrivals(0) {}
+
+// Maximum number of alerts kept for the API
+static const size_t MAX_RECENT_ALERTS = 100;
+
+// Zone ids in zone array order
+static std::vector<std::string> collectZoneIds(Zone** zoneArray, int zCount) {
+    std::vector<std::string> ids;
+    for (int i = 0; i < zCount; i++) {
+        ids.push_back(zoneArray[i]->getZoneId());
+    }
+    return ids;
+}
+
+// CachedText constructor
+CachedText::CachedText() : valid(false), version(0) {}
+
 // Analytics constructor
 Analytics::Analytics(ParkingRequest** reqArray, int reqCount, Zone** zoneArray, int zCount)
-    : requests(reqArray), requestCount(reqCount), zones(zoneArray), zoneCount(zCount) {}
+    : zones(zoneArray), zoneCount(zCount), zoneSeries(zCount > 0 ? zCount : 0),
+      zoneForecasters(zCount > 0 ? zCount : 0), zoneAnomalies(zCount > 0 ? zCount : 0),
+      heatmap(collectZoneIds(zoneArray, zCount)),
+      lastCheckTime(0),
+      zoneHitters(64), vehicleHitters(64), overflowHitters(32), stateVersion(0) {
+    // Zone handles in the history follow the zone array order
+    for (int i = 0; i < zoneCount; i++) {
+        history.internZone(zones[i]->getZoneId());
+    }
+    
+    requests.reserve(reqCount);
+    for (int i = 0; i < reqCount; i++) {
+        trackRequest(reqArray[i]);
+    }
+}
 
-// Get average parking duration
-double Analytics::getAverageParkingDuration() const {
-    if (requestCount == 0) return 0.0;
+// Start tracking a request: fold in its current state and observe transitions
+void Analytics::trackRequest(ParkingRequest* request) {
+    if (!request) return;
     
-    double totalDuration = 0.0;
-    int completedCount = 0;
+    requests.push_back(request);
+    accumulate(*request);
+    request->setObserver(this);
+    markChanged();
+}
+
+// Fold a request's current state into the running counters
+void Analytics::accumulate(const ParkingRequest& request) {
+    AnalyticsCounters& tc = typeCounters[request.getVehicleType()];
+    counters.totalRequests++;
+    counters.stateCounts[request.getState()]++;
+    tc.totalRequests++;
+    tc.stateCounts[request.getState()]++;
+    activityWindow.recordRequest(request.getRequestTime());
+    zoneCounters[request.getPreferredZone()].arrivals++;
     
-    for (int i = 0; i < requestCount; i++) {
+    if (!request.getAllocatedZone().empty()) {
+        recordAllocation(request);
+    }
+    if (request.getState() == RELEASED) {
+        recordCompletion(request);
+    } else if (request.getState() == CANCELLED) {
+        recordCancellation(request);
+    }
+}
+
+// Update running counters after a request transition (O(1))
+void Analytics::onRequestTransition(const ParkingRequest& request, RequestState previousState) {
+    RequestState state = request.getState();
+    AnalyticsCounters& tc = typeCounters[request.getVehicleType()];
+    counters.stateCounts[previousState]--;
+    counters.stateCounts[state]++;
+    tc.stateCounts[previousState]--;
+    tc.stateCounts[state]++;
+    
+    if (state == ALLOCATED) {
+        recordAllocation(request);
+    } else if (state == RELEASED) {
+        recordCompletion(request);
+    } else if (state == CANCELLED) {
+        recordCancellation(request);
+    }
+    markChanged();
+}
+
+// Count an allocation against its zone and the heavy-hitter trackers
+void Analytics::recordAllocation(const ParkingRequest& request) {
+    std::string zone = request.getAllocatedZone();
+    zoneCounters[zone].allocations++;
+    
+    activityWindow.recordAllocation(request.getAllocationTime());
+    zoneVisitors[zone].add(request.getAllocationTime(), request.getVehicleId());
+    zoneHitters.offer(zone);
+    vehicleHitters.offer(request.getVehicleId());
+    if (request.getIsCrossZone()) {
+        overflowHitters.offer(request.getPreferredZone() + "->" + zone);
+    }
+}
+
+// Fold a released request into revenue, duration and distribution aggregates
+void Analytics::recordCompletion(const ParkingRequest& request) {
+    double cost = request.getTotalCost();
+    double duration = request.getDuration();
+    
+    ZoneCounters& zc = zoneCounters[request.getAllocatedZone()];
+    zc.completed++;
+    zc.revenue += cost;
+    zc.duration += duration;
+    
+    counters.recordCompletion(cost, duration, request.getIsCrossZone());
+    typeCounters[request.getVehicleType()].recordCompletion(cost, duration, request.getIsCrossZone());
+    
+    activityWindow.recordCompletion(request.getCompletionTime(), cost, duration,
+                                    request.getIsCrossZone());
+    history.append(request);
+    
+    UsageDistribution* targets[] = {
+        &overallDistribution,
+        &typeDistributions[request.getVehicleType()],
+        &zoneDistributions[request.getAllocatedZone()]
+    };
+    for (UsageDistribution* target : targets) {
+        target->duration.add(duration);
+        target->cost.add(cost);
+    }
+}
+
+// Record a cancelled request in the activity window
+void Analytics::recordCancellation(const ParkingRequest& request) {
+    activityWindow.recordCancellation(request.getCompletionTime());
+    history.append(request);
+}
+
+// Get running counters
+const AnalyticsCounters& Analytics::getCounters() const {
+    return counters;
+}
+
+// Get running counters for one vehicle type
+const AnalyticsCounters& Analytics::getTypeCounters(VehicleType type) const {
+    return typeCounters[type];
+}
+
+// Find counters for a zone (nullptr if the zone has no activity)
+const ZoneCounters* Analytics::findZoneCounters(const std::string& zoneId) const {
+    auto it = zoneCounters.find(zoneId);
+    return it == zoneCounters.end() ? nullptr : &it->second;
+}
+
+// Find zone position in the zone array
+int Analytics::findZoneIndex(const std::string& zoneId) const {
+    for (int i = 0; i < zoneCount; i++) {
+        if (zones[i]->getZoneId() == zoneId) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Count requests in a given state by scanning history
+int Analytics::scanStateCount(RequestState state) const {
+    int count = 0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (requests[i]->getState() == state) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Sum revenue of released requests by scanning history
+double Analytics::scanTotalRevenue() const {
+    double total = 0.0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (requests[i]->getState() == RELEASED) {
+            total += requests[i]->getTotalCost();
+        }
+    }
+    return total;
+}
+
+// Sum duration of released requests by scanning history
+double Analytics::scanTotalDuration() const {
+    double total = 0.0;
+    for (size_t i = 0; i < requests.size(); i++) {
         if (requests[i]->getState() == RELEASED) {
-            totalDuration += requests[i]->getDuration();
-            completedCount++;
+            total += requests[i]->getDuration();
+        }
+    }
+    return total;
+}
+
+// Count released cross-zone requests by scanning history
+int Analytics::scanCrossZoneAllocations() const {
+    int count = 0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (requests[i]->getState() == RELEASED && 
+            requests[i]->getIsCrossZone()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Sum revenue for one zone by scanning history
+double Analytics::scanRevenueByZone(const std::string& zoneId) const {
+    double total = 0.0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (requests[i]->getState() == RELEASED && 
+            requests[i]->getAllocatedZone() == zoneId) {
+            total += requests[i]->getTotalCost();
         }
     }
+    return total;
+}
+
+// Count allocations for one zone by scanning history
+int Analytics::scanAllocationsByZone(const std::string& zoneId) const {
+    int count = 0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (requests[i]->getAllocatedZone() == zoneId) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Check running counters against a full rescan of the request history
+bool Analytics::verifyCounters() const {
+    const double epsilon = 1e-6;
     
+    if (counters.totalRequests != static_cast<int>(requests.size())) return false;
+    for (int s = 0; s < REQUEST_STATE_COUNT; s++) {
+        if (counters.stateCounts[s] != scanStateCount(static_cast<RequestState>(s))) {
+            return false;
+        }
+    }
+    if (std::fabs(counters.totalRevenue - scanTotalRevenue()) > epsilon) return false;
+    if (std::fabs(counters.totalDuration - scanTotalDuration()) > epsilon) return false;
+    if (counters.crossZoneCompleted != scanCrossZoneAllocations()) return false;
+    
+    // Per-type counters must add up to the global ones
+    AnalyticsCounters typeTotal;
+    for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+        typeTotal.totalRequests += typeCounters[t].totalRequests;
+        for (int s = 0; s < REQUEST_STATE_COUNT; s++) {
+            typeTotal.stateCounts[s] += typeCounters[t].stateCounts[s];
+        }
+        typeTotal.recordCompletion(typeCounters[t].totalRevenue, typeCounters[t].totalDuration, false);
+        typeTotal.crossZoneCompleted += typeCounters[t].crossZoneCompleted;
+    }
+    if (typeTotal.totalRequests != counters.totalRequests) return false;
+    for (int s = 0; s < REQUEST_STATE_COUNT; s++) {
+        if (typeTotal.stateCounts[s] != counters.stateCounts[s]) return false;
+    }
+    if (std::fabs(typeTotal.totalRevenue - counters.totalRevenue) > epsilon) return false;
+    if (typeTotal.crossZoneCompleted != counters.crossZoneCompleted) return false;
+    
+    for (const auto& pair : zoneCounters) {
+        if (pair.first.empty()) continue;
+        if (pair.second.allocations != scanAllocationsByZone(pair.first)) return false;
+        if (std::fabs(pair.second.revenue - scanRevenueByZone(pair.first)) > epsilon) return false;
+    }
+    return true;
+}
+
+// Get average parking duration
+double Analytics::getAverageParkingDuration() const {
+    int completedCount = counters.stateCounts[RELEASED];
     if (completedCount == 0) return 0.0;
-    return totalDuration / completedCount;
+    return counters.totalDuration / completedCount;
 }
 
 // Get zone utilization rate
@@ -47,150 +329,302 @@ std::vector<double> Analytics::getAllZoneUtilizationRates() const {
     return rates;
 }
 
+// Get total tracked requests
+int Analytics::getTotalRequests() const {
+    return counters.totalRequests;
+}
+
 // Get completed requests count
 int Analytics::getCompletedRequests() const {
-    int count = 0;
-    for (int i = 0; i < requestCount; i++) {
-        if (requests[i]->getState() == RELEASED) {
-            count++;
-        }
-    }
-    return count;
+    return counters.stateCounts[RELEASED];
 }
 
 // Get cancelled requests count
 int Analytics::getCancelledRequests() const {
-    int count = 0;
-    for (int i = 0; i < requestCount; i++) {
-        if (requests[i]->getState() == CANCELLED) {
-            count++;
-        }
-    }
-    return count;
+    return counters.stateCounts[CANCELLED];
 }
 
 // Get completion rate
 double Analytics::getCompletionRate() const {
-    if (requestCount == 0) return 0.0;
-    return (static_cast<double>(getCompletedRequests()) / requestCount) * 100.0;
+    if (counters.totalRequests == 0) return 0.0;
+    return (static_cast<double>(getCompletedRequests()) / counters.totalRequests) * 100.0;
 }
 
 // Get cancellation rate
 double Analytics::getCancellationRate() const {
-    if (requestCount == 0) return 0.0;
-    return (static_cast<double>(getCancelledRequests()) / requestCount) * 100.0;
+    if (counters.totalRequests == 0) return 0.0;
+    return (static_cast<double>(getCancelledRequests()) / counters.totalRequests) * 100.0;
 }
 
-// Get peak usage zone
-std::string Analytics::getPeakUsageZone() const {
-    if (requestCount == 0) return "No requests";
-    
-    std::map<std::string, int> zoneCounts;
-    
-    // Count allocations per zone
-    for (int i = 0; i < requestCount; i++) {
-        std::string zone = requests[i]->getAllocatedZone();
-        if (!zone.empty()) {
-            zoneCounts[zone]++;
+// Get totals for the last windowSeconds (O(buckets))
+WindowTotals Analytics::getWindowTotals(int windowSeconds, time_t now) const {
+    return activityWindow.getTotals(now, windowSeconds);
+}
+
+// Get totals since tracking started
+WindowTotals Analytics::getLifetimeTotals() const {
+    WindowTotals totals;
+    totals.requests = counters.totalRequests;
+    totals.completed = counters.stateCounts[RELEASED];
+    totals.cancelled = counters.stateCounts[CANCELLED];
+    totals.crossZoneCompleted = counters.crossZoneCompleted;
+    totals.revenue = counters.totalRevenue;
+    totals.duration = counters.totalDuration;
+    for (const auto& pair : zoneCounters) {
+        totals.allocations += pair.second.allocations;
+    }
+    return totals;
+}
+
+// Estimate distinct vehicles in a zone (or all zones) over recent days
+double Analytics::getUniqueVehicles(const std::string& zoneId, int days, time_t now) const {
+    HyperLogLog merged;
+    if (zoneId.empty()) {
+        for (const auto& pair : zoneVisitors) {
+            pair.second.mergeInto(merged, now, days);
         }
+    } else {
+        auto it = zoneVisitors.find(zoneId);
+        if (it == zoneVisitors.end()) return 0.0;
+        it->second.mergeInto(merged, now, days);
     }
-    
-    // Find zone with max count
-    std::string peakZone;
-    int maxCount = 0;
-    
-    for (const auto& pair : zoneCounts) {
-        if (pair.second > maxCount) {
-            maxCount = pair.second;
-            peakZone = pair.first;
+    return merged.estimate();
+}
+
+// Get the columnar request archive
+const RequestHistory& Analytics::getHistory() const {
+    return history;
+}
+
+// Record one occupancy sample per zone and run the anomaly detectors
+void Analytics::sampleOccupancy(time_t now) {
+    for (int i = 0; i < zoneCount; i++) {
+        double utilization = zones[i]->getUtilizationRate();
+        zoneSeries[i].recordSample(now, utilization);
+        zoneForecasters[i].update(now, utilization / 100.0);
+        heatmap.addSample(i, now, utilization);
+    }
+    checkAnomalies(now);
+    markChanged();
+}
+
+// Count a parking request for its preferred zone
+void Analytics::recordArrival(const std::string& zoneId) {
+    for (int i = 0; i < zoneCount; i++) {
+        if (zones[i]->getZoneId() == zoneId) {
+            zoneAnomalies[i].arrivalCount++;
+            return;
         }
     }
-    
-    return peakZone.empty() ? "No allocations" : peakZone;
 }
 
-// Get top N peak usage zones
-std::vector<std::string> Analytics::getPeakUsageZones(int topN) const {
-    std::map<std::string, int> zoneCounts;
+// Feed each zone's utilization and arrival rate to its detectors
+void Analytics::checkAnomalies(time_t now) {
+    double minutes = lastCheckTime > 0 ? (now - lastCheckTime) / 60.0 : 0.0;
     
-    // Count allocations per zone
-    for (int i = 0; i < requestCount; i++) {
-        std::string zone = requests[i]->getAllocatedZone();
-        if (!zone.empty()) {
-            zoneCounts[zone]++;
+    for (int i = 0; i < zoneCount; i++) {
+        double utilization = zones[i]->getUtilizationRate();
+        ZoneAnomalyState& state = zoneAnomalies[i];
+        double score = 0.0;
+        double expected = state.occupancy.getMean();
+        AnomalyKind kind = state.occupancy.update(utilization, score);
+        if (kind != ANOMALY_NONE) {
+            raiseAlert(i, "occupancy", kind, utilization, expected, score, now);
         }
+        
+        int arrivals = state.arrivalCount;
+        if (minutes > 0.0) {
+            double rate = (arrivals - state.lastArrivals) / minutes;
+            expected = state.arrivals.getMean();
+            kind = state.arrivals.update(rate, score);
+            if (kind != ANOMALY_NONE) {
+                raiseAlert(i, "arrivals", kind, rate, expected, score, now);
+            }
+        }
+        state.lastArrivals = arrivals;
     }
+    lastCheckTime = now;
+}
+
+// Store an alert and pass it to the callback
+void Analytics::raiseAlert(int zoneIndex, const char* metric, AnomalyKind kind,
+                           double value, double expected, double score, time_t now) {
+    AnomalyAlert alert;
+    alert.zoneId = zones[zoneIndex]->getZoneId();
+    alert.metric = metric;
+    alert.kind = kind;
+    alert.value = value;
+    alert.expected = expected;
+    alert.score = score;
+    alert.timestamp = now;
     
-    // Convert to vector for sorting
-    std::vector<std::pair<std::string, int>> zonesVector(zoneCounts.begin(), zoneCounts.end());
-    
-    // Sort by count (descending)
-    std::sort(zonesVector.begin(), zonesVector.end(),
-              [](const auto& a, const auto& b) {
-                  return a.second > b.second;
-              });
+    recentAlerts.push_back(alert);
+    if (recentAlerts.size() > MAX_RECENT_ALERTS) {
+        recentAlerts.pop_front();
+    }
+    if (alertCallback) {
+        alertCallback(alert);
+    }
+}
+
+// Get the hour-of-week occupancy heatmap
+const OccupancyHeatmap& Analytics::getHeatmap() const {
+    return heatmap;
+}
+
+// Get heatmap as JSON
+std::string Analytics::getHeatmapJson() const {
+    return getCached(cachedHeatmapJson, &Analytics::buildHeatmapJson);
+}
+
+// Get heatmap in the compact binary layout
+std::string Analytics::getHeatmapBinary() const {
+    return getCached(cachedHeatmapBinary, &Analytics::buildHeatmapBinary);
+}
+
+// Build heatmap JSON (uncached)
+std::string Analytics::buildHeatmapJson() const {
+    return heatmap.toJson();
+}
+
+// Build heatmap binary payload (uncached)
+std::string Analytics::buildHeatmapBinary() const {
+    return heatmap.toBinary();
+}
+
+// Set the function called for each new alert
+void Analytics::setAlertCallback(AnomalyCallback callback) {
+    alertCallback = callback;
+}
+
+// Get up to maxAlerts recent alerts, newest first
+std::vector<AnomalyAlert> Analytics::getRecentAlerts(int maxAlerts) const {
+    std::vector<AnomalyAlert> result;
+    for (auto it = recentAlerts.rbegin();
+         it != recentAlerts.rend() && (int)result.size() < maxAlerts; ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+// Get recent alerts as a JSON array
+std::string Analytics::getRecentAlertsJson(int maxAlerts) const {
+    std::string out;
+    JsonWriter writer(out);
+    writeAlertsJson(writer, maxAlerts);
+    return out;
+}
+
+// Serialize recent alerts, newest first
+void Analytics::writeAlertsJson(JsonWriter& writer, int maxAlerts) const {
+    writer.beginArray();
+    int written = 0;
+    for (auto it = recentAlerts.rbegin(); it != recentAlerts.rend() && written < maxAlerts; ++it) {
+        writer.beginObject()
+              .field("zoneId", it->zoneId)
+              .field("metric", it->metric)
+              .field("kind", it->getKindString())
+              .field("value", it->value, 2)
+              .field("expected", it->expected, 2)
+              .field("score", it->score, 2)
+              .field("timestamp", static_cast<long long>(it->timestamp))
+              .endObject();
+        written++;
+    }
+    writer.endArray();
+}
+
+// Get occupancy buckets for a zone in a time range
+std::vector<OccupancyBucket> Analytics::getOccupancySeries(const std::string& zoneId,
+                                                           time_t from, time_t to,
+                                                           SeriesResolution resolution) const {
+    int index = findZoneIndex(zoneId);
+    if (index < 0) return std::vector<OccupancyBucket>();
+    return zoneSeries[index].query(from, to, resolution);
+}
+
+// Get predicted free slots in a zone minutesAhead from now
+int Analytics::getPredictedFreeSlots(const std::string& zoneId, int minutesAhead, time_t now) const {
+    int index = findZoneIndex(zoneId);
+    if (index < 0) return 0;
+    if (!zoneForecasters[index].isReady()) return zones[index]->getAvailableSlots();
+    return zoneForecasters[index].forecastFreeSlots(zones[index]->getTotalSlots(), now, minutesAhead);
+}
+
+// Get per-zone forecasters
+const OccupancyForecaster* Analytics::getForecasters() const {
+    return zoneForecasters.empty() ? nullptr : zoneForecasters.data();
+}
+
+// Get distribution over all released requests
+const UsageDistribution& Analytics::getOverallDistribution() const {
+    return overallDistribution;
+}
+
+// Get distribution for one vehicle type
+const UsageDistribution& Analytics::getTypeDistribution(VehicleType type) const {
+    return typeDistributions[type];
+}
+
+// Get distribution for one zone (nullptr if nothing was released there)
+const UsageDistribution* Analytics::getZoneDistribution(const std::string& zoneId) const {
+    auto it = zoneDistributions.find(zoneId);
+    return it == zoneDistributions.end() ? nullptr : &it->second;
+}
+
+// Get peak usage zone
+std::string Analytics::getPeakUsageZone() const {
+    if (counters.totalRequests == 0) return "No requests";
     
-    // Get top N
+    std::vector<HeavyHitter> peak = zoneHitters.top(1);
+    return peak.empty() ? "No allocations" : peak[0].key;
+}
+
+// Get top N peak usage zones
+std::vector<std::string> Analytics::getPeakUsageZones(int topN) const {
     std::vector<std::string> result;
-    int count = 0;
-    for (const auto& pair : zonesVector) {
-        if (count >= topN) break;
-        result.push_back(pair.first + " (" + std::to_string(pair.second) + " requests)");
-        count++;
+    for (const HeavyHitter& hitter : zoneHitters.top(topN)) {
+        result.push_back(hitter.key + " (" + std::to_string(hitter.count) + " requests)");
     }
-    
     return result;
 }
 
+// Get top N zones by allocations
+std::vector<HeavyHitter> Analytics::getTopZones(int topN) const {
+    return zoneHitters.top(topN);
+}
+
+// Get top N vehicles by allocations
+std::vector<HeavyHitter> Analytics::getTopVehicles(int topN) const {
+    return vehicleHitters.top(topN);
+}
+
+// Get top N preferred->allocated overflow routes
+std::vector<HeavyHitter> Analytics::getTopOverflowRoutes(int topN) const {
+    return overflowHitters.top(topN);
+}
+
 // Get total revenue
 double Analytics::getTotalRevenue() const {
-    double total = 0.0;
-    for (int i = 0; i < requestCount; i++) {
-        if (requests[i]->getState() == RELEASED) {
-            total += requests[i]->getTotalCost();
-        }
-    }
-    return total;
+    return counters.totalRevenue;
 }
 
 // Get average revenue per hour
 double Analytics::getAverageRevenuePerHour() const {
-    int completed = getCompletedRequests();
-    if (completed == 0) return 0.0;
-    
-    double totalDuration = 0.0;
-    for (int i = 0; i < requestCount; i++) {
-        if (requests[i]->getState() == RELEASED) {
-            totalDuration += requests[i]->getDuration();
-        }
-    }
-    
-    if (totalDuration == 0.0) return 0.0;
-    return getTotalRevenue() / totalDuration;
+    if (counters.stateCounts[RELEASED] == 0) return 0.0;
+    if (counters.totalDuration == 0.0) return 0.0;
+    return counters.totalRevenue / counters.totalDuration;
 }
 
 // Get revenue by zone
 double Analytics::getRevenueByZone(const std::string& zoneId) const {
-    double total = 0.0;
-    for (int i = 0; i < requestCount; i++) {
-        if (requests[i]->getState() == RELEASED && 
-            requests[i]->getAllocatedZone() == zoneId) {
-            total += requests[i]->getTotalCost();
-        }
-    }
-    return total;
+    const ZoneCounters* zc = findZoneCounters(zoneId);
+    return zc ? zc->revenue : 0.0;
 }
 
 // Get cross-zone allocations count
 int Analytics::getCrossZoneAllocations() const {
-    int count = 0;
-    for (int i = 0; i < requestCount; i++) {
-        if (requests[i]->getState() == RELEASED && 
-            requests[i]->getIsCrossZone()) {
-            count++;
-        }
-    }
-    return count;
+    return counters.crossZoneCompleted;
 }
 
 // Get cross-zone allocation rate
@@ -201,23 +635,38 @@ double Analytics::getCrossZoneRate() const {
     return (static_cast<double>(getCrossZoneAllocations()) / completed) * 100.0;
 }
 
+// Build summary text
+std::string Analytics::buildSummary() const {
+    std::stringstream ss;
+    ss << "\n=== PARKING ANALYTICS SUMMARY ===" << std::endl;
+    ss << "Total Requests: " << counters.totalRequests << std::endl;
+    ss << "Completed: " << getCompletedRequests() 
+       << " (" << std::fixed << std::setprecision(1) << getCompletionRate() << "%)" << std::endl;
+    ss << "Cancelled: " << getCancelledRequests() 
+       << " (" << std::fixed << std::setprecision(1) << getCancellationRate() << "%)" << std::endl;
+    ss << "Average Duration: " << std::fixed << std::setprecision(1) 
+       << getAverageParkingDuration() << " hours" << std::endl;
+    ss << "Duration p50/p95/p99: " << std::fixed << std::setprecision(1)
+       << overallDistribution.duration.quantile(0.50) << " / "
+       << overallDistribution.duration.quantile(0.95) << " / "
+       << overallDistribution.duration.quantile(0.99) << " hours" << std::endl;
+    ss << "Total Revenue: $" << std::fixed << std::setprecision(2) 
+       << getTotalRevenue() << std::endl;
+    ss << "Cost p50/p95/p99: $" << std::fixed << std::setprecision(2)
+       << overallDistribution.cost.quantile(0.50) << " / $"
+       << overallDistribution.cost.quantile(0.95) << " / $"
+       << overallDistribution.cost.quantile(0.99) << std::endl;
+    ss << "Average Revenue/Hour: $" << std::fixed << std::setprecision(2) 
+       << getAverageRevenuePerHour() << std::endl;
+    ss << "Cross-Zone Allocations: " << getCrossZoneAllocations() 
+       << " (" << std::fixed << std::setprecision(1) << getCrossZoneRate() << "%)" << std::endl;
+    ss << "Peak Usage Zone: " << getPeakUsageZone() << std::endl;
+    return ss.str();
+}
+
 // Display summary
 void Analytics::displaySummary() const {
-    std::cout << "\n=== PARKING ANALYTICS SUMMARY ===" << std::endl;
-    std::cout << "Total Requests: " << requestCount << std::endl;
-    std::cout << "Completed: " << getCompletedRequests() 
-              << " (" << std::fixed << std::setprecision(1) << getCompletionRate() << "%)" << std::endl;
-    std::cout << "Cancelled: " << getCancelledRequests() 
-              << " (" << std::fixed << std::setprecision(1) << getCancellationRate() << "%)" << std::endl;
-    std::cout << "Average Duration: " << std::fixed << std::setprecision(1) 
-              << getAverageParkingDuration() << " hours" << std::endl;
-    std::cout << "Total Revenue: $" << std::fixed << std::setprecision(2) 
-              << getTotalRevenue() << std::endl;
-    std::cout << "Average Revenue/Hour: $" << std::fixed << std::setprecision(2) 
-              << getAverageRevenuePerHour() << std::endl;
-    std::cout << "Cross-Zone Allocations: " << getCrossZoneAllocations() 
-              << " (" << std::fixed << std::setprecision(1) << getCrossZoneRate() << "%)" << std::endl;
-    std::cout << "Peak Usage Zone: " << getPeakUsageZone() << std::endl;
+    std::cout << getCached(cachedSummary, &Analytics::buildSummary);
 }
 
 // Display detailed report
@@ -233,6 +682,17 @@ void Analytics::displayDetailedReport() const {
                   << getRevenueByZone(zones[i]->getZoneId()) << std::endl;
     }
     
+    std::cout << "\n=== VEHICLE TYPES ===" << std::endl;
+    for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+        const AnalyticsCounters& tc = typeCounters[t];
+        int completed = tc.stateCounts[RELEASED];
+        std::cout << getVehicleTypeInfo(static_cast<VehicleType>(t)).name << ": "
+                  << tc.totalRequests << " requests | " << completed << " completed | Revenue: $"
+                  << std::fixed << std::setprecision(2) << tc.totalRevenue << " | Avg Duration: "
+                  << std::fixed << std::setprecision(1)
+                  << (completed > 0 ? tc.totalDuration / completed : 0.0) << " hours" << std::endl;
+    }
+    
     std::cout << "\n=== TOP ZONES BY USAGE ===" << std::endl;
     std::vector<std::string> topZones = getPeakUsageZones(3);
     for (size_t i = 0; i < topZones.size(); i++) {
@@ -240,15 +700,118 @@ void Analytics::displayDetailedReport() const {
     }
 }
 
-// Generate report string
-std::string Analytics::generateReport() const {
+// Display detailed report recomputed from the request archive, with the
+// scan partitioned across threadCount workers
+void Analytics::displayDetailedReport(int threadCount) const {
+    HistoryAggregates agg = history.aggregateParallel(threadCount);
+    long long archived = static_cast<long long>(history.size());
+    long long completed = agg.stateCounts[RELEASED];
+    long long cancelled = agg.stateCounts[CANCELLED];
+    
+    std::cout << "\n=== HISTORICAL ANALYTICS REPORT ===" << std::endl;
+    std::cout << "Archived Requests: " << archived << std::endl;
+    std::cout << "Completed: " << completed << std::endl;
+    std::cout << "Cancelled: " << cancelled << std::endl;
+    std::cout << "Average Duration: " << std::fixed << std::setprecision(1)
+              << (completed > 0 ? agg.duration / completed : 0.0) << " hours" << std::endl;
+    std::cout << "Total Revenue: $" << std::fixed << std::setprecision(2)
+              << agg.revenue << std::endl;
+    std::cout << "Average Revenue/Hour: $" << std::fixed << std::setprecision(2)
+              << (agg.duration > 0.0 ? agg.revenue / agg.duration : 0.0) << std::endl;
+    std::cout << "Cross-Zone Rate: " << std::fixed << std::setprecision(1)
+              << (completed > 0 ? (static_cast<double>(agg.crossZoneCompleted) / completed) * 100.0 : 0.0)
+              << "%" << std::endl;
+    
+    std::cout << "\n=== REVENUE BY ZONE ===" << std::endl;
+    for (size_t z = 0; z < agg.revenueByZone.size(); z++) {
+        std::string zoneId = history.getZoneId(static_cast<uint16_t>(z));
+        if (zoneId.empty()) continue;
+        std::cout << zoneId << ": $" << std::fixed << std::setprecision(2)
+                  << agg.revenueByZone[z] << std::endl;
+    }
+}
+
+// Build report string
+std::string Analytics::buildReport() const {
     std::stringstream ss;
     ss << "Parking System Analytics Report\n";
     ss << "===============================\n";
-    ss << "Total Requests: " << requestCount << "\n";
+    ss << "Total Requests: " << counters.totalRequests << "\n";
     ss << "Completed: " << getCompletedRequests() << "\n";
     ss << "Cancelled: " << getCancelledRequests() << "\n";
     ss << "Total Revenue: $" << std::fixed << std::setprecision(2) << getTotalRevenue() << "\n";
     ss << "Cross-Zone Rate: " << std::fixed << std::setprecision(1) << getCrossZoneRate() << "%\n";
     return ss.str();
 }
+
+// Build JSON payload for the analytics endpoint
+std::string Analytics::buildReportJson() const {
+    std::string out;
+    out.reserve(384);
+    JsonWriter writer(out);
+    writeJson(writer);
+    return out;
+}
+
+// Serialize the headline report
+void Analytics::writeJson(JsonWriter& writer) const {
+    writer.beginObject()
+          .field("version", getStateVersion())
+          .field("totalRequests", counters.totalRequests)
+          .field("completedRequests", getCompletedRequests())
+          .field("cancelledRequests", getCancelledRequests())
+          .field("completionRate", getCompletionRate(), 2)
+          .field("cancellationRate", getCancellationRate(), 2)
+          .field("averageDuration", getAverageParkingDuration(), 2)
+          .field("totalRevenue", getTotalRevenue(), 2)
+          .field("averageRevenuePerHour", getAverageRevenuePerHour(), 2)
+          .field("crossZoneRate", getCrossZoneRate(), 2)
+          .field("peakZone", getPeakUsageZone())
+          .endObject();
+}
+
+// Return cached text, rebuilding it if the state version moved on
+std::string Analytics::getCached(CachedText& cache, std::string (Analytics::*builder)() const) const {
+    uint64_t version = getStateVersion();
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (!cache.valid || cache.version != version) {
+        cache.text = (this->*builder)();
+        cache.version = version;
+        cache.valid = true;
+    }
+    return cache.text;
+}
+
+// Generate report string
+std::string Analytics::generateReport() const {
+    return getCached(cachedReport, &Analytics::buildReport);
+}
+
+// Generate JSON report
+std::string Analytics::generateReportJson() const {
+    return getCached(cachedReportJson, &Analytics::buildReportJson);
+}
+
+// Get current state version
+uint64_t Analytics::getStateVersion() const {
+    return stateVersion.load(std::memory_order_acquire);
+}
+
+// Record a change that invalidates cached reports
+void Analytics::markChanged() {
+    stateVersion.fetch_add(1, std::memory_order_acq_rel);
+}
+
+// Rebuild stale API payloads (from a background thread while the caller
+// holds the system lock), so the next reader gets a cache hit
+void Analytics::refreshCachedReports() const {
+    getCached(cachedReportJson, &Analytics::buildReportJson);
+    getCached(cachedHeatmapJson, &Analytics::buildHeatmapJson);
+}
+
+// Check whether the report JSON was built for the current state version
+bool Analytics::isReportJsonCurrent() const {
+    uint64_t version = getStateVersion();
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cachedReportJson.valid && cachedReportJson.version == version;
+}
@@ -0,0 +1,86 @@
+#include "../include/AnomalyDetector.h"
+#include <cmath>
+
+// AnomalyAlert constructor
+AnomalyAlert::AnomalyAlert()
+    : kind(ANOMALY_NONE), value(0.0), expected(0.0), score(0.0), timestamp(0) {}
+
+// Get alert kind as string
+std::string AnomalyAlert::getKindString() const {
+    switch (kind) {
+        case ANOMALY_SPIKE: return "SPIKE";
+        case ANOMALY_DROP: return "DROP";
+        case ANOMALY_SHIFT_UP: return "SHIFT_UP";
+        case ANOMALY_SHIFT_DOWN: return "SHIFT_DOWN";
+        default: return "NONE";
+    }
+}
+
+// AnomalyDetector constructor
+AnomalyDetector::AnomalyDetector(double minimumStdDev, double ewmaAlpha, double zLimit,
+                                 double slack, double limit, int warmup)
+    : alpha(ewmaAlpha), zThreshold(zLimit), cusumSlack(slack), cusumLimit(limit),
+      minStdDev(minimumStdDev), warmupSamples(warmup),
+      mean(0.0), variance(0.0), cusumHigh(0.0), cusumLow(0.0), count(0) {}
+
+// Feed one sample
+AnomalyKind AnomalyDetector::update(double value, double& score) {
+    AnomalyKind kind = ANOMALY_NONE;
+    score = 0.0;
+    
+    if (count == 0) {
+        mean = value;
+        variance = 0.0;
+    } else if (count >= warmupSamples) {
+        double z = (value - mean) / getStdDev();
+        
+        cusumHigh = std::fmax(0.0, cusumHigh + z - cusumSlack);
+        cusumLow = std::fmax(0.0, cusumLow - z - cusumSlack);
+        
+        if (z > zThreshold) {
+            kind = ANOMALY_SPIKE;
+            score = z;
+        } else if (z < -zThreshold) {
+            kind = ANOMALY_DROP;
+            score = z;
+        } else if (cusumHigh > cusumLimit) {
+            kind = ANOMALY_SHIFT_UP;
+            score = cusumHigh;
+        } else if (cusumLow > cusumLimit) {
+            kind = ANOMALY_SHIFT_DOWN;
+            score = -cusumLow;
+        }
+        
+        // Start a fresh change-point search after any alarm
+        if (kind != ANOMALY_NONE) {
+            cusumHigh = 0.0;
+            cusumLow = 0.0;
+        }
+    }
+    
+    // EWMA mean and variance (West's incremental form)
+    if (count > 0) {
+        double diff = value - mean;
+        double increment = alpha * diff;
+        mean += increment;
+        variance = (1.0 - alpha) * (variance + diff * increment);
+    }
+    count++;
+    
+    return kind;
+}
+
+// Get smoothed mean
+double AnomalyDetector::getMean() const {
+    return mean;
+}
+
+// Get smoothed standard deviation (never below the floor)
+double AnomalyDetector::getStdDev() const {
+    return std::fmax(std::sqrt(variance), minStdDev);
+}
+
+// Get number of samples seen
+long long AnomalyDetector::getCount() const {
+    return count;
+}
@@ -0,0 +1,1388 @@
+#include "../include/HttpServer.h"
+#include "../include/Metrics.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <mutex>
+#include <exception>
+#include <chrono>
+#include <algorithm>
+
+// Events a stream may have queued before it is treated as a stalled reader
+static const size_t MAX_STREAM_BACKLOG = 256;
+
+// Backpressure: a connection with this much output waiting is not read and
+// its pipelined requests are not run until the client drains it; unread
+// input is capped likewise while the connection cannot act on it
+static const size_t MAX_PENDING_OUTPUT = 256 * 1024;
+static const size_t MAX_PENDING_INPUT = 64 * 1024;
+
+// Per-connection state, owned by one worker
+struct HttpConnection {
+    int fd;
+    std::string inBuffer;
+    HttpOutput output;
+    HttpRequestParser parser;
+    HttpResponse response;   // reused for every request on the connection
+    bool closeAfterWrite;
+    bool wantWrite;        // EPOLLOUT registered
+    time_t lastActivity;
+    std::string channel;   // event-stream channel, empty for request/response
+    uint32_t clientAddress;  // IPv4, host order; the rate-limit key
+    bool queued;           // head request is waiting in a worker queue
+    bool peerClosed;       // no more input; close once queued work is answered
+    bool touched;          // has new output to flush this pass
+    bool readPaused;       // input not watched: backlog over the limits, or input ended
+    bool outputHeld;       // buffered requests wait for the client to read output
+
+    // Async handler in progress; it reads its own copy of the request
+    HttpTask task;
+    std::string asyncBytes;
+    HttpRequestParser asyncParser;
+    std::chrono::steady_clock::time_point asyncStart;
+    MetricHistogram* asyncLatency;
+    bool suspended;        // waiting on offloaded work
+    bool abandoned;        // closed while the handler ran; close when it finishes
+
+    explicit HttpConnection(int socketFd)
+        : fd(socketFd), closeAfterWrite(false), wantWrite(false),
+          lastActivity(time(nullptr)), clientAddress(0), queued(false),
+          peerClosed(false), touched(false), readPaused(false), outputHeld(false),
+          asyncLatency(nullptr),
+          suspended(false), abandoned(false) {}
+};
+
+// A connection whose head request is waiting to be dispatched
+struct QueuedRequest {
+    int fd;
+    std::chrono::steady_clock::time_point enqueued;
+};
+
+// One epoll loop and the connections it serves
+struct HttpWorker {
+    int epollFd;
+    int wakeFd;
+    std::mutex pendingMutex;
+    std::vector<int> pendingFds;   // accepted sockets not yet registered
+    int listenFd;                  // own SO_REUSEPORT socket in thread-per-core mode
+    std::vector<std::pair<std::string, std::shared_ptr<const std::string>>> pendingEvents;
+    std::vector<std::pair<int, std::coroutine_handle<>>> pendingResumes;   // finished offloads
+    std::deque<QueuedRequest> queues[PRIORITY_COUNT];   // drained every loop pass
+    std::vector<int> touched;                           // connections to flush this pass
+    std::vector<int> held;                              // output drained; run their held requests
+
+    // Admission counters; written only by this worker
+    std::atomic<uint64_t> admitted[PRIORITY_COUNT];
+    std::atomic<uint64_t> shedQueueFull[PRIORITY_COUNT];
+    std::atomic<uint64_t> shedQueueDelay[PRIORITY_COUNT];
+    std::atomic<uint64_t> rateLimited;
+    LocalRateLimiter rateLimiter;   // thread-per-core mode: this worker's clients only
+    std::unordered_map<int, std::unique_ptr<HttpConnection>> connections;
+    std::thread thread;
+
+    HttpWorker() : epollFd(-1), wakeFd(-1), listenFd(-1), rateLimited(0) {
+        for (int i = 0; i < PRIORITY_COUNT; i++) {
+            admitted[i] = 0;
+            shedQueueFull[i] = 0;
+            shedQueueDelay[i] = 0;
+        }
+    }
+};
+
+// Process-wide server metrics. The per-worker admission counters stay
+// because getAdmissionStats() reports on one server.
+struct HttpMetrics {
+    MetricCounter* responses[5];   // by status class, 1xx to 5xx
+    MetricCounter* admitted[PRIORITY_COUNT];
+    MetricCounter* shedQueueFull[PRIORITY_COUNT];
+    MetricCounter* shedQueueDelay[PRIORITY_COUNT];
+    MetricCounter* rateLimited;
+    MetricGauge* connections;
+    MetricGauge* streams;
+    MetricGauge* suspended;
+
+    HttpMetrics() {
+        MetricsRegistry& registry = metrics();
+        const char* classes[] = {"1xx", "2xx", "3xx", "4xx", "5xx"};
+        for (int i = 0; i < 5; i++) {
+            responses[i] = &registry.counter("nexuspark_http_responses_total", "HTTP responses by status class",
+                                             MetricsRegistry::label("code", classes[i]));
+        }
+        const char* lanes[] = {"read", "write"};
+        for (int i = 0; i < PRIORITY_COUNT; i++) {
+            std::string lane = MetricsRegistry::label("priority", lanes[i]);
+            admitted[i] = &registry.counter("nexuspark_http_admitted_total",
+                                            "Requests admitted to a handler", lane);
+            shedQueueFull[i] = &registry.counter("nexuspark_http_shed_total", "Requests answered without a handler",
+                                                 MetricsRegistry::label("reason", "queue_full") + "," + lane);
+            shedQueueDelay[i] = &registry.counter("nexuspark_http_shed_total", "Requests answered without a handler",
+                                                  MetricsRegistry::label("reason", "queue_delay") + "," + lane);
+        }
+        rateLimited = &registry.counter("nexuspark_http_shed_total", "Requests answered without a handler",
+                                        MetricsRegistry::label("reason", "rate_limited"));
+        connections = &registry.gauge("nexuspark_http_open_connections", "Open client connections");
+        streams = &registry.gauge("nexuspark_http_open_streams", "Open event-stream connections");
+        suspended = &registry.gauge("nexuspark_http_suspended_handlers", "Async handlers waiting on offloaded work");
+    }
+};
+
+// Get the server metrics (registered on first use)
+static HttpMetrics& httpMetrics() {
+    static HttpMetrics instance;
+    return instance;
+}
+
+// Count a response by status class
+static void countResponse(int status) {
+    int statusClass = status / 100;
+    if (statusClass >= 1 && statusClass <= 5) httpMetrics().responses[statusClass - 1]->increment();
+}
+
+// The server, worker and connection whose async handler is running on
+// this thread; submitOffload() routes the resumption back through them
+struct AsyncContext {
+    HttpServer* server;
+    HttpWorker* worker;
+    int fd;
+};
+static thread_local AsyncContext asyncContext = {nullptr, nullptr, -1};
+
+// Sets the async context for the lifetime of a handler step
+struct AsyncScope {
+    AsyncContext saved;
+
+    AsyncScope(HttpServer* server, HttpWorker* worker, int fd) : saved(asyncContext) {
+        asyncContext.server = server;
+        asyncContext.worker = worker;
+        asyncContext.fd = fd;
+    }
+    ~AsyncScope() { asyncContext = saved; }
+};
+
+// Run job on the server's blocking pool, then queue the coroutine to be
+// resumed by the worker it suspended on
+bool submitOffload(std::function<void()> job, std::coroutine_handle<> resume) {
+    AsyncContext context = asyncContext;
+    if (!context.server) {
+        job();
+        return false;
+    }
+    context.server->offload([job, context, resume]() {
+        job();
+        {
+            std::lock_guard<std::mutex> lock(context.worker->pendingMutex);
+            context.worker->pendingResumes.emplace_back(context.fd, resume);
+        }
+        uint64_t wake = 1;
+        (void)!write(context.worker->wakeFd, &wake, sizeof(wake));
+    });
+    return true;
+}
+
+// Request latency histogram of one route
+static MetricHistogram& routeLatency(const std::string& route) {
+    return metrics().histogram("nexuspark_http_request_duration_seconds", "Handler latency by route",
+                               MetricsRegistry::label("route", route));
+}
+
+// Case-insensitive ASCII comparison
+static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+        if (x != y) return false;
+    }
+    return true;
+}
+
+// Strip spaces and tabs from both ends
+static std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+// HttpRequest constructor
+HttpRequest::HttpRequest() : keepAlive(true) {}
+
+// Get a header value by name
+std::string_view HttpRequest::getHeader(std::string_view name) const {
+    for (const auto& header : headers) {
+        if (equalsIgnoreCase(header.first, name)) return header.second;
+    }
+    return std::string_view();
+}
+
+// Get a raw (undecoded) query parameter by name
+std::string_view HttpRequest::getQueryParam(std::string_view name) const {
+    std::string_view rest = query;
+    while (!rest.empty()) {
+        size_t amp = rest.find('&');
+        std::string_view pair = rest.substr(0, amp);
+        size_t eq = pair.find('=');
+        if (pair.substr(0, eq) == name) {
+            return eq == std::string_view::npos ? std::string_view() : pair.substr(eq + 1);
+        }
+        if (amp == std::string_view::npos) break;
+        rest.remove_prefix(amp + 1);
+    }
+    return std::string_view();
+}
+
+// HttpResponse constructor
+HttpResponse::HttpResponse()
+    : status(200), contentType("application/json"), fileFd(-1), fileLength(0) {}
+
+// Close an unsent file body
+HttpResponse::~HttpResponse() {
+    if (fileFd >= 0) close(fileFd);
+}
+
+// Length of whichever body is set
+size_t HttpResponse::getContentLength() const {
+    if (fileFd >= 0) return fileLength;
+    if (sharedBody) return sharedBody->size();
+    return body.size();
+}
+
+// Add or replace a response header
+void HttpResponse::setHeader(const std::string& name, const std::string& value) {
+    for (auto& header : headers) {
+        if (equalsIgnoreCase(header.first, name)) {
+            header.second = value;
+            return;
+        }
+    }
+    headers.emplace_back(name, value);
+}
+
+// Reset for the next request without releasing the body's capacity
+void HttpResponse::reset() {
+    status = 200;
+    contentType = "application/json";
+    body.clear();
+    sharedBody.reset();
+    if (fileFd >= 0) close(fileFd);
+    fileFd = -1;
+    fileLength = 0;
+    headers.clear();
+    streamChannel.clear();
+}
+
+// Turn the response into an event stream on channel
+void HttpResponse::openStream(const std::string& channel) {
+    status = 200;
+    contentType = "text/event-stream";
+    streamChannel = channel;
+}
+
+// Check for an event-stream response
+bool HttpResponse::isStream() const {
+    return !streamChannel.empty();
+}
+
+// Reason phrase for a status code
+const char* getHttpStatusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 204: return "No Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 408: return "Request Timeout";
+        case 411: return "Length Required";
+        case 413: return "Payload Too Large";
+        case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default: return "Unknown";
+    }
+}
+
+// HttpRequestParser constructor
+HttpRequestParser::HttpRequestParser() {
+    reset();
+}
+
+// Prepare for the next request on the connection
+void HttpRequestParser::reset() {
+    scanned = 0;
+    headerLength = 0;
+    contentLength = 0;
+    errorStatus = 0;
+    anchor = nullptr;
+    request = HttpRequest();
+}
+
+// Record a parse error
+ParseResult HttpRequestParser::fail(int status) {
+    errorStatus = status;
+    return PARSE_ERROR;
+}
+
+// Parse the request line and headers (head excludes the blank line)
+bool HttpRequestParser::parseHeaders(std::string_view head) {
+    size_t lineEnd = head.find("\r\n");
+    std::string_view line = head.substr(0, lineEnd);
+
+    // Request line: METHOD SP target SP version
+    size_t sp1 = line.find(' ');
+    size_t sp2 = sp1 == std::string_view::npos ? sp1 : line.find(' ', sp1 + 1);
+    if (sp1 == 0 || sp2 == std::string_view::npos) return false;
+    request.method = line.substr(0, sp1);
+    request.target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+    std::string_view version = line.substr(sp2 + 1);
+    if (request.target.empty() || version.substr(0, 7) != "HTTP/1.") return false;
+
+    size_t question = request.target.find('?');
+    request.path = request.target.substr(0, question);
+    if (question != std::string_view::npos) {
+        request.query = request.target.substr(question + 1);
+    }
+    bool http10 = version == "HTTP/1.0";
+
+    // Header lines
+    std::string_view rest = lineEnd == std::string_view::npos ? std::string_view()
+                                                              : head.substr(lineEnd + 2);
+    while (!rest.empty()) {
+        size_t end = rest.find("\r\n");
+        std::string_view headerLine = rest.substr(0, end);
+        size_t colon = headerLine.find(':');
+        if (colon == std::string_view::npos || colon == 0) return false;
+        if (request.headers.size() >= MAX_HEADERS) return false;
+        request.headers.emplace_back(headerLine.substr(0, colon), trim(headerLine.substr(colon + 1)));
+        if (end == std::string_view::npos) break;
+        rest.remove_prefix(end + 2);
+    }
+
+    std::string_view connection = request.getHeader("Connection");
+    if (http10) {
+        request.keepAlive = equalsIgnoreCase(connection, "keep-alive");
+    } else {
+        request.keepAlive = !equalsIgnoreCase(connection, "close");
+    }
+    return true;
+}
+
+// Parse as much of the request at the start of buffer as is available
+ParseResult HttpRequestParser::parse(std::string_view buffer) {
+    if (errorStatus != 0) return PARSE_ERROR;
+
+    if (headerLength == 0) {
+        // Resume the terminator search, backing up in case it straddles reads
+        size_t from = scanned >= 3 ? scanned - 3 : 0;
+        size_t end = buffer.find("\r\n\r\n", from);
+        if (end == std::string_view::npos) {
+            scanned = buffer.size();
+            if (buffer.size() > MAX_HEADER_BYTES) return fail(431);
+            return PARSE_INCOMPLETE;
+        }
+        if (end + 4 > MAX_HEADER_BYTES) return fail(431);
+        if (!parseHeaders(buffer.substr(0, end))) return fail(400);
+        headerLength = end + 4;
+        anchor = buffer.data();
+
+        if (!request.getHeader("Transfer-Encoding").empty()) return fail(501);
+        std::string_view length = request.getHeader("Content-Length");
+        if (!length.empty()) {
+            size_t value = 0;
+            for (char c : length) {
+                if (c < '0' || c > '9') return fail(400);
+                value = value * 10 + static_cast<size_t>(c - '0');
+                if (value > MAX_BODY_BYTES) return fail(413);
+            }
+            contentLength = value;
+        }
+    }
+
+    if (buffer.size() < headerLength + contentLength) return PARSE_INCOMPLETE;
+
+    // Re-anchor views if the buffer was reallocated while the body arrived
+    if (anchor != buffer.data()) {
+        request = HttpRequest();
+        if (!parseHeaders(buffer.substr(0, headerLength - 4))) return fail(400);
+        anchor = buffer.data();
+    }
+    request.body = buffer.substr(headerLength, contentLength);
+    return PARSE_COMPLETE;
+}
+
+// Get the parsed request
+const HttpRequest& HttpRequestParser::getRequest() const {
+    return request;
+}
+
+// Get the length of the complete request
+size_t HttpRequestParser::getMessageLength() const {
+    return headerLength + contentLength;
+}
+
+// Get the status for a parse error
+int HttpRequestParser::getErrorStatus() const {
+    return errorStatus;
+}
+
+// Segment constructor
+HttpOutput::Segment::Segment() : fd(-1), fileOffset(0), sent(0), length(0) {}
+
+// HttpOutput constructor
+HttpOutput::HttpOutput() {}
+
+// Close any file descriptors that were never sent
+HttpOutput::~HttpOutput() {
+    for (Segment& segment : segments) {
+        if (segment.fd >= 0) close(segment.fd);
+    }
+}
+
+// Bytes segment at the end of the queue
+std::string& HttpOutput::tail() {
+    if (segments.empty() || segments.back().shared || segments.back().fd >= 0) {
+        segments.emplace_back();
+    }
+    return segments.back().bytes;
+}
+
+// Queue a shared buffer without copying it
+void HttpOutput::appendShared(const std::shared_ptr<const std::string>& buffer) {
+    if (!buffer || buffer->empty()) return;
+    segments.emplace_back();
+    segments.back().shared = buffer;
+    segments.back().length = buffer->size();
+}
+
+// Queue a whole file for sendfile
+void HttpOutput::appendFile(int fd, size_t length) {
+    if (length == 0) {
+        close(fd);
+        return;
+    }
+    segments.emplace_back();
+    segments.back().fd = fd;
+    segments.back().length = length;
+}
+
+// Serialize a response, moving its shared or file body into the queue
+void HttpOutput::appendResponse(HttpResponse& response, bool keepAlive,
+                                const std::vector<std::pair<std::string, std::string>>& defaults,
+                                bool headOnly) {
+    std::string& out = tail();
+    out += "HTTP/1.1 ";
+    out += std::to_string(response.status);
+    out += ' ';
+    out += getHttpStatusText(response.status);
+    out += "\r\n";
+    // 204 and 304 carry no body and no representation headers
+    bool bodyless = response.status == 204 || response.status == 304;
+    if (response.isStream()) {
+        // Open-ended body: no length, delimited by the connection
+        out += "Content-Type: text/event-stream\r\nCache-Control: no-cache\r\n";
+    } else if (!bodyless) {
+        out += "Content-Type: ";
+        out += response.contentType;
+        out += "\r\nContent-Length: ";
+        out += std::to_string(response.getContentLength());
+        out += "\r\n";
+    }
+    for (const auto& header : defaults) {
+        out += header.first + ": " + header.second + "\r\n";
+    }
+    for (const auto& header : response.headers) {
+        out += header.first + ": " + header.second + "\r\n";
+    }
+    out += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    
+    if (bodyless || headOnly) {
+        if (response.fileFd >= 0) close(response.fileFd);
+        response.fileFd = -1;
+        response.sharedBody.reset();
+    } else if (response.fileFd >= 0) {
+        appendFile(response.fileFd, response.fileLength);
+        response.fileFd = -1;
+    } else if (response.sharedBody) {
+        appendShared(response.sharedBody);
+        response.sharedBody.reset();
+    } else {
+        out += response.body;
+    }
+}
+
+// Write queued segments to the socket
+int HttpOutput::flush(int socketFd) {
+    while (!segments.empty()) {
+        Segment& segment = segments.front();
+        ssize_t n;
+        if (segment.fd >= 0) {
+            n = sendfile(socketFd, segment.fd, &segment.fileOffset, segment.length - segment.sent);
+        } else {
+            const std::string& data = segment.shared ? *segment.shared : segment.bytes;
+            if (!segment.shared) segment.length = data.size();
+            n = send(socketFd, data.data() + segment.sent, data.size() - segment.sent, MSG_NOSIGNAL);
+        }
+        
+        if (n > 0) {
+            segment.sent += static_cast<size_t>(n);
+            if (segment.sent >= segment.length) {
+                if (segment.fd >= 0) close(segment.fd);
+                segments.pop_front();
+            }
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 0;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return -1;  // error, or the file shrank underneath us
+        }
+    }
+    return 1;
+}
+
+// Check for pending output
+bool HttpOutput::empty() const {
+    return segments.empty();
+}
+
+// Get number of queued segments
+size_t HttpOutput::getSegmentCount() const {
+    return segments.size();
+}
+
+// Get bytes queued and not yet sent
+size_t HttpOutput::getPendingBytes() const {
+    size_t total = 0;
+    for (const Segment& segment : segments) {
+        size_t length = (segment.shared || segment.fd >= 0) ? segment.length : segment.bytes.size();
+        total += length - segment.sent;
+    }
+    return total;
+}
+
+// Check whether a connection has buffered more than it may before it is
+// read again. Input only counts while the connection cannot make progress
+// on it (a handler is suspended, or responses are waiting to be sent).
+static bool isBacklogged(const HttpConnection& conn) {
+    size_t output = conn.output.getPendingBytes();
+    return output >= MAX_PENDING_OUTPUT ||
+           (conn.inBuffer.size() >= MAX_PENDING_INPUT && (conn.task || output > 0));
+}
+
+// Update a connection's epoll interest
+static void watch(int epollFd, HttpConnection& conn, bool writable) {
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    uint32_t events = conn.readPaused ? 0u : static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP);
+    if (writable) events |= EPOLLOUT;
+    ev.events = events;
+    ev.data.fd = conn.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.fd, &ev);
+    conn.wantWrite = writable;
+}
+
+// Write pending output and update the epoll interest: writes while output
+// is blocked, reads unless the backlog is over the limits or input ended.
+// Returns false when the connection should close.
+static bool flushConnection(int epollFd, HttpConnection& conn) {
+    int result = conn.output.flush(conn.fd);
+    if (result < 0) return false;
+    bool writable = result == 0;
+    bool paused = conn.peerClosed || isBacklogged(conn);
+    if (writable != conn.wantWrite || paused != conn.readPaused) {
+        conn.readPaused = paused;
+        watch(epollFd, conn, writable);
+    }
+    return writable || !conn.closeAfterWrite;
+}
+
+// HttpServer constructor
+HttpServer::HttpServer(int listenPort, int workers)
+    : port(listenPort), workerCount(workers > 0 ? workers : 1), listenFd(-1), stopFd(-1),
+      running(false), idleTimeoutSeconds(60), streamCount(0), threadPerCore(false),
+      fallbackLatency(&routeLatency("other")), suspendedCount(0), offloadThreadCount(2),
+      offloadStopping(false) {}
+
+// HttpServer destructor
+HttpServer::~HttpServer() {
+    stop();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+    // Offloaded jobs point into suspended frames, which die with the connections
+    stopOffloadPool();
+    httpMetrics().suspended->add(-suspendedCount.load());
+    for (auto& worker : workers) {
+        httpMetrics().connections->add(-static_cast<int64_t>(worker->connections.size()));
+        for (auto& entry : worker->connections) close(entry.first);
+        for (int fd : worker->pendingFds) close(fd);
+        if (worker->epollFd >= 0) close(worker->epollFd);
+        if (worker->wakeFd >= 0) close(worker->wakeFd);
+        if (worker->listenFd >= 0) close(worker->listenFd);
+    }
+    httpMetrics().streams->add(-streamCount.load());
+    if (listenFd >= 0) close(listenFd);
+    if (stopFd >= 0) close(stopFd);
+}
+
+// Register a handler for an exact method and path
+void HttpServer::route(const std::string& method, const std::string& path, HttpHandler handler) {
+    std::string key = method + " " + path;
+    Route& entry = routes[key];
+    entry.handler = handler;
+    entry.asyncHandler = nullptr;
+    entry.latency = &routeLatency(key);
+}
+
+// Register a coroutine handler for an exact method and path
+void HttpServer::routeAsync(const std::string& method, const std::string& path, AsyncHttpHandler handler) {
+    std::string key = method + " " + path;
+    Route& entry = routes[key];
+    entry.handler = nullptr;
+    entry.asyncHandler = handler;
+    entry.latency = &routeLatency(key);
+}
+
+// Handler for requests without a route
+void HttpServer::setFallback(HttpHandler handler) {
+    fallback = handler;
+}
+
+// Header added to every response
+void HttpServer::addDefaultHeader(const std::string& name, const std::string& value) {
+    defaultHeaders.emplace_back(name, value);
+}
+
+// Close keep-alive connections idle for this long
+void HttpServer::setIdleTimeout(int seconds) {
+    idleTimeoutSeconds = seconds > 0 ? seconds : 1;
+}
+
+// Threads running offloaded work for async handlers
+void HttpServer::setOffloadThreads(int count) {
+    offloadThreadCount = count > 0 ? count : 1;
+}
+
+// One listener per worker with SO_REUSEPORT and CPU pinning
+void HttpServer::setThreadPerCore(bool enabled) {
+    threadPerCore = enabled;
+}
+
+// Open a non-blocking listening socket; updates listenPort if it was 0
+static int openListener(int& listenPort, bool reusePort) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (reusePort) {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+    }
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(listenPort));
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(fd, SOMAXCONN) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    socklen_t len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    listenPort = ntohs(addr.sin_port);
+    return fd;
+}
+
+// Bind the listening socket(s) and create the worker loops
+bool HttpServer::start() {
+    if (!threadPerCore) {
+        listenFd = openListener(port, false);
+        if (listenFd < 0) return false;
+    }
+
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    for (int i = 0; i < workerCount; i++) {
+        std::unique_ptr<HttpWorker> worker(new HttpWorker());
+        worker->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        worker->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = worker->wakeFd;
+        epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, worker->wakeFd, &ev);
+
+        // The first socket fixes an ephemeral port; the rest share it
+        if (threadPerCore) {
+            worker->rateLimiter.configure(admission.clientRate, admission.clientBurst);
+            worker->listenFd = openListener(port, true);
+            if (worker->listenFd < 0) {
+                workers.push_back(std::move(worker));
+                return false;
+            }
+            ev.data.fd = worker->listenFd;
+            epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, worker->listenFd, &ev);
+        }
+        workers.push_back(std::move(worker));
+    }
+    running = true;
+    return true;
+}
+
+// Serve until stopped
+void HttpServer::run() {
+    if (!running || workers.empty()) return;
+    for (int i = 0; i < offloadThreadCount; i++) {
+        offloadThreads.emplace_back([this]() { offloadLoop(); });
+    }
+    int cpuCount = static_cast<int>(std::thread::hardware_concurrency());
+    for (size_t i = 0; i < workers.size(); i++) {
+        HttpWorker* w = workers[i].get();
+        w->thread = std::thread([this, w]() { workerLoop(*w); });
+        if (threadPerCore && cpuCount > 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(static_cast<int>(i) % cpuCount, &cpus);
+            pthread_setaffinity_np(w->thread.native_handle(), sizeof(cpus), &cpus);
+        }
+    }
+    if (threadPerCore) {
+        // Workers accept for themselves; just wait for stop()
+        pollfd stopPoll;
+        stopPoll.fd = stopFd;
+        stopPoll.events = POLLIN;
+        while (running) {
+            poll(&stopPoll, 1, -1);
+        }
+    } else {
+        acceptLoop();
+    }
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+    stopOffloadPool();
+}
+
+// Stop the blocking pool and wait for its threads (after the workers exit)
+void HttpServer::stopOffloadPool() {
+    {
+        std::lock_guard<std::mutex> lock(offloadMutex);
+        offloadStopping = true;
+    }
+    offloadReady.notify_all();
+    for (std::thread& thread : offloadThreads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+// Ask the accept loop and workers to exit. Async-signal-safe: only an
+// atomic exchange and eventfd writes; run() stops the blocking pool.
+void HttpServer::stop() {
+    if (!running.exchange(false)) return;
+    uint64_t one = 1;
+    if (stopFd >= 0) (void)!write(stopFd, &one, sizeof(one));
+    for (auto& worker : workers) {
+        (void)!write(worker->wakeFd, &one, sizeof(one));
+    }
+}
+
+// Get the bound port
+int HttpServer::getPort() const {
+    return port;
+}
+
+// Get the number of worker loops
+int HttpServer::getWorkerCount() const {
+    return workerCount;
+}
+
+// Check for thread-per-core mode
+bool HttpServer::isThreadPerCore() const {
+    return threadPerCore;
+}
+
+// Queue bounds and rate limits (before start)
+void HttpServer::setAdmission(const AdmissionConfig& config) {
+    admission = config;
+    rateLimiter.configure(config.clientRate, config.clientBurst);
+}
+
+// Get the admission settings
+const AdmissionConfig& HttpServer::getAdmission() const {
+    return admission;
+}
+
+// Sum the workers' admission counters
+AdmissionStats HttpServer::getAdmissionStats() const {
+    AdmissionStats stats;
+    for (const auto& worker : workers) {
+        for (int i = 0; i < PRIORITY_COUNT; i++) {
+            stats.admitted[i] += worker->admitted[i].load(std::memory_order_relaxed);
+            stats.shedQueueFull[i] += worker->shedQueueFull[i].load(std::memory_order_relaxed);
+            stats.shedQueueDelay[i] += worker->shedQueueDelay[i].load(std::memory_order_relaxed);
+        }
+        stats.rateLimited += worker->rateLimited.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+// Reads are side-effect free and cheap; everything else is a write
+RequestPriority HttpServer::classify(const HttpRequest& request) {
+    if (request.method == "GET" || request.method == "HEAD" || request.method == "OPTIONS") {
+        return PRIORITY_READ;
+    }
+    return PRIORITY_WRITE;
+}
+
+// Answer the head request without running its handler
+void HttpServer::shed(HttpConnection& conn, int status, int retryAfterSeconds) {
+    const HttpRequest& request = conn.parser.getRequest();
+    HttpResponse& response = conn.response;
+    response.reset();
+    response.status = status;
+    response.contentType = "text/plain";
+    response.body = getHttpStatusText(status);
+    response.setHeader("Retry-After", std::to_string(retryAfterSeconds > 0 ? retryAfterSeconds : 1));
+    countResponse(status);
+    conn.output.appendResponse(response, request.keepAlive, defaultHeaders, request.method == "HEAD");
+    if (!request.keepAlive) conn.closeAfterWrite = true;
+    conn.inBuffer.erase(0, conn.parser.getMessageLength());
+    conn.parser.reset();
+}
+
+// Queue the connection's next complete request, answering it at once if
+// it is malformed, over its client's rate, or its lane is full
+void HttpServer::scheduleNext(HttpWorker& worker, HttpConnection& conn) {
+    if (!conn.touched) {
+        conn.touched = true;
+        worker.touched.push_back(conn.fd);
+    }
+    while (!conn.queued && !conn.task && !conn.closeAfterWrite && conn.channel.empty()) {
+        if (!conn.inBuffer.empty() && conn.output.getPendingBytes() >= MAX_PENDING_OUTPUT) {
+            // Picked up again by the worker loop once the client reads
+            conn.outputHeld = true;
+            return;
+        }
+        ParseResult result = conn.inBuffer.empty() ? PARSE_INCOMPLETE : conn.parser.parse(conn.inBuffer);
+        if (result == PARSE_INCOMPLETE) {
+            if (conn.peerClosed) conn.closeAfterWrite = true;
+            return;
+        }
+        if (result == PARSE_ERROR) {
+            HttpResponse error;
+            error.status = conn.parser.getErrorStatus();
+            error.contentType = "text/plain";
+            error.body = getHttpStatusText(error.status);
+            conn.output.appendResponse(error, false, defaultHeaders);
+            conn.closeAfterWrite = true;
+            return;
+        }
+
+        // Thread-per-core workers charge their own buckets; no lock is shared
+        double retryAfter;
+        bool allowed = true;
+        if (threadPerCore) {
+            allowed = !worker.rateLimiter.isEnabled() ||
+                      worker.rateLimiter.allow(conn.clientAddress, monotonicSeconds(), retryAfter);
+        } else if (rateLimiter.isEnabled()) {
+            allowed = rateLimiter.allow(conn.clientAddress, monotonicSeconds(), retryAfter);
+        }
+        if (!allowed) {
+            worker.rateLimited.fetch_add(1, std::memory_order_relaxed);
+            httpMetrics().rateLimited->increment();
+            shed(conn, 429, static_cast<int>(std::ceil(retryAfter)));
+            continue;
+        }
+
+        RequestPriority priority = classify(conn.parser.getRequest());
+        if (worker.queues[priority].size() >= admission.maxQueued[priority]) {
+            worker.shedQueueFull[priority].fetch_add(1, std::memory_order_relaxed);
+            httpMetrics().shedQueueFull[priority]->increment();
+            shed(conn, 503, admission.retryAfterSeconds);
+            continue;
+        }
+        QueuedRequest entry;
+        entry.fd = conn.fd;
+        entry.enqueued = std::chrono::steady_clock::now();
+        worker.queues[priority].push_back(entry);
+        conn.queued = true;
+    }
+}
+
+// Dispatch queued requests, reads first; requests that waited past their
+// lane's limit are answered 503 so the backlog clears quickly
+void HttpServer::processQueues(HttpWorker& worker) {
+    while (!worker.queues[PRIORITY_READ].empty() || !worker.queues[PRIORITY_WRITE].empty()) {
+        RequestPriority priority = worker.queues[PRIORITY_READ].empty() ? PRIORITY_WRITE : PRIORITY_READ;
+        QueuedRequest entry = worker.queues[priority].front();
+        worker.queues[priority].pop_front();
+
+        auto it = worker.connections.find(entry.fd);
+        if (it == worker.connections.end()) continue;
+        HttpConnection& conn = *it->second;
+        conn.queued = false;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        long long waitedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.enqueued).count();
+        if (waitedMs > admission.maxQueueDelayMs[priority]) {
+            worker.shedQueueDelay[priority].fetch_add(1, std::memory_order_relaxed);
+            httpMetrics().shedQueueDelay[priority]->increment();
+            shed(conn, 503, admission.retryAfterSeconds);
+        } else {
+            worker.admitted[priority].fetch_add(1, std::memory_order_relaxed);
+            httpMetrics().admitted[priority]->increment();
+            const HttpRequest& request = conn.parser.getRequest();
+            const Route* route = findRoute(request);
+            if (route && route->asyncHandler) {
+                beginAsync(worker, conn, *route);
+            } else {
+                dispatchRoute(route, request, conn.response, conn.output);
+                if (conn.response.isStream() && request.method != "HEAD") {
+                    // The connection now only carries events; ignore further input
+                    conn.channel = conn.response.streamChannel;
+                    streamCount.fetch_add(1);
+                    httpMetrics().streams->add(1);
+                    conn.inBuffer.clear();
+                    conn.parser.reset();
+                } else {
+                    if (!request.keepAlive) conn.closeAfterWrite = true;
+                    conn.inBuffer.erase(0, conn.parser.getMessageLength());
+                    conn.parser.reset();
+                }
+            }
+        }
+        // A pipelined follow-up goes to the back of its lane
+        scheduleNext(worker, conn);
+    }
+}
+
+// Get the number of open event streams
+int HttpServer::getStreamCount() const {
+    return streamCount.load();
+}
+
+// Get the number of async handlers waiting on offloaded work
+int HttpServer::getSuspendedCount() const {
+    return suspendedCount.load();
+}
+
+// Queue a job for the blocking pool
+void HttpServer::offload(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(offloadMutex);
+        offloadJobs.push_back(std::move(job));
+    }
+    offloadReady.notify_one();
+}
+
+// Blocking pool thread; jobs still queued at stop are dropped
+void HttpServer::offloadLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(offloadMutex);
+            offloadReady.wait(lock, [this]() { return offloadStopping || !offloadJobs.empty(); });
+            if (offloadStopping) return;
+            job = std::move(offloadJobs.front());
+            offloadJobs.pop_front();
+        }
+        job();
+    }
+}
+
+// Start an async handler on its own copy of the request, which later reads
+// into the receive buffer cannot move
+void HttpServer::beginAsync(HttpWorker& worker, HttpConnection& conn, const Route& route) {
+    size_t length = conn.parser.getMessageLength();
+    conn.asyncBytes.assign(conn.inBuffer, 0, length);
+    conn.inBuffer.erase(0, length);
+    conn.parser.reset();
+    conn.asyncParser.reset();
+    conn.asyncParser.parse(conn.asyncBytes);
+    conn.response.reset();
+    conn.asyncStart = std::chrono::steady_clock::now();
+    conn.asyncLatency = route.latency;
+
+    try {
+        conn.task = route.asyncHandler(conn.asyncParser.getRequest(), conn.response);
+    } catch (const std::exception& e) {
+        conn.response.reset();
+        conn.response.status = 500;
+        conn.response.contentType = "text/plain";
+        conn.response.body = e.what();
+        finishAsync(worker, conn);
+        return;
+    }
+    resumeAsync(worker, conn, conn.task.getHandle());
+}
+
+// Run an async handler to its next suspension point
+void HttpServer::resumeAsync(HttpWorker& worker, HttpConnection& conn, std::coroutine_handle<> handle) {
+    {
+        AsyncScope scope(this, &worker, conn.fd);
+        handle.resume();
+    }
+    if (conn.task.done()) {
+        finishAsync(worker, conn);
+    } else if (!conn.suspended) {
+        conn.suspended = true;
+        suspendedCount.fetch_add(1);
+        httpMetrics().suspended->add(1);
+    }
+}
+
+// Send a finished async handler's response and move on to the next request
+void HttpServer::finishAsync(HttpWorker& worker, HttpConnection& conn) {
+    if (conn.suspended) {
+        conn.suspended = false;
+        suspendedCount.fetch_sub(1);
+        httpMetrics().suspended->add(-1);
+    }
+    try {
+        conn.task.rethrow();
+    } catch (const std::exception& e) {
+        conn.response.reset();
+        conn.response.status = 500;
+        conn.response.contentType = "text/plain";
+        conn.response.body = e.what();
+    }
+    conn.task = HttpTask();
+    conn.asyncLatency->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - conn.asyncStart).count()));
+    if (conn.abandoned) return;
+
+    countResponse(conn.response.status);
+    const HttpRequest& request = conn.asyncParser.getRequest();
+    conn.output.appendResponse(conn.response, request.keepAlive, defaultHeaders, request.method == "HEAD");
+    if (!request.keepAlive) conn.closeAfterWrite = true;
+    conn.lastActivity = time(nullptr);
+    scheduleNext(worker, conn);
+}
+
+// Hand an event to every worker; each appends it to its own subscribers
+void HttpServer::publish(const std::string& channel, const std::string& event) {
+    std::shared_ptr<const std::string> shared = std::make_shared<const std::string>(event);
+    uint64_t wake = 1;
+    for (auto& worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->pendingMutex);
+            worker->pendingEvents.emplace_back(channel, shared);
+        }
+        (void)!write(worker->wakeFd, &wake, sizeof(wake));
+    }
+}
+
+// Accept connections and hand them to workers round-robin
+void HttpServer::acceptLoop() {
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+    ev.data.fd = stopFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &ev);
+
+    size_t next = 0;
+    epoll_event events[2];
+    while (running) {
+        int n = epoll_wait(epollFd, events, 2, -1);
+        if (n < 0 && errno != EINTR) break;
+        for (int i = 0; i < n && running; i++) {
+            if (events[i].data.fd != listenFd) continue;
+            while (true) {
+                int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) break;
+                int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+                HttpWorker& worker = *workers[next++ % workers.size()];
+                {
+                    std::lock_guard<std::mutex> lock(worker.pendingMutex);
+                    worker.pendingFds.push_back(fd);
+                }
+                uint64_t wake = 1;
+                (void)!write(worker.wakeFd, &wake, sizeof(wake));
+            }
+        }
+    }
+    close(epollFd);
+}
+
+// Find the route for a request, or nullptr. HEAD falls back to the GET
+// route; its body is dropped when the response is serialized.
+const HttpServer::Route* HttpServer::findRoute(const HttpRequest& request) const {
+    std::string key;
+    key.reserve(request.method.size() + 1 + request.path.size());
+    key.append(request.method).append(1, ' ').append(request.path);
+    auto it = routes.find(key);
+    if (it == routes.end() && request.method == "HEAD") {
+        key.replace(0, 4, "GET");
+        it = routes.find(key);
+    }
+    return it != routes.end() ? &it->second : nullptr;
+}
+
+// Route a request and append the serialized response
+void HttpServer::dispatch(const HttpRequest& request, HttpResponse& response,
+                          HttpOutput& out) const {
+    dispatchRoute(findRoute(request), request, response, out);
+}
+
+// Run a synchronous handler (or the fallback) and append the response
+void HttpServer::dispatchRoute(const Route* route, const HttpRequest& request, HttpResponse& response,
+                               HttpOutput& out) const {
+    response.reset();
+    {
+        ScopedTimer timer(route ? *route->latency : *fallbackLatency);
+        try {
+            if (route && route->handler) {
+                route->handler(request, response);
+            } else if (route) {
+                response.status = 500;
+                response.contentType = "text/plain";
+                response.body = "Asynchronous route";
+            } else if (fallback) {
+                fallback(request, response);
+            } else {
+                response.status = 404;
+                response.contentType = "text/plain";
+                response.body = "Not Found";
+            }
+        } catch (const std::exception& e) {
+            response.reset();
+            response.status = 500;
+            response.contentType = "text/plain";
+            response.body = e.what();
+        }
+    }
+    countResponse(response.status);
+    out.appendResponse(response, request.keepAlive, defaultHeaders, request.method == "HEAD");
+}
+
+// Event loop for one worker
+void HttpServer::workerLoop(HttpWorker& worker) {
+    const int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    char readBuffer[16 * 1024];
+    time_t lastSweep = time(nullptr);
+
+    auto closeConnection = [this, &worker](int fd) {
+        auto it = worker.connections.find(fd);
+        if (it != worker.connections.end() && it->second->task) {
+            // The suspended handler still uses the connection; close when it finishes
+            it->second->abandoned = true;
+            epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            return;
+        }
+        if (it != worker.connections.end()) {
+            httpMetrics().connections->add(-1);
+            if (!it->second->channel.empty()) {
+                streamCount.fetch_sub(1);
+                httpMetrics().streams->add(-1);
+            }
+        }
+        epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        worker.connections.erase(fd);
+    };
+
+    // Once a held connection's output drops below the limit, run its
+    // buffered requests on the next pass
+    auto releaseHeld = [&worker](HttpConnection& conn) {
+        if (conn.outputHeld && conn.output.getPendingBytes() < MAX_PENDING_OUTPUT) {
+            conn.outputHeld = false;
+            worker.held.push_back(conn.fd);
+        }
+    };
+
+    auto addConnection = [&worker](int clientFd) {
+        sockaddr_in peer;
+        socklen_t peerLength = sizeof(peer);
+        std::memset(&peer, 0, sizeof(peer));
+        getpeername(clientFd, reinterpret_cast<sockaddr*>(&peer), &peerLength);
+
+        epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = clientFd;
+        if (epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, clientFd, &ev) < 0) {
+            close(clientFd);
+            return;
+        }
+        HttpConnection* conn = new HttpConnection(clientFd);
+        conn->clientAddress = ntohl(peer.sin_addr.s_addr);
+        worker.connections[clientFd].reset(conn);
+        httpMetrics().connections->add(1);
+    };
+
+    while (running) {
+        int n = epoll_wait(worker.epollFd, events, MAX_EVENTS, worker.held.empty() ? 1000 : 0);
+        if (n < 0 && errno != EINTR) break;
+
+        std::vector<int> held;
+        held.swap(worker.held);
+        for (int fd : held) {
+            auto it = worker.connections.find(fd);
+            if (it != worker.connections.end()) scheduleNext(worker, *it->second);
+        }
+
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+
+            // New connections from the acceptor, or published events
+            if (fd == worker.wakeFd) {
+                uint64_t value;
+                (void)!read(worker.wakeFd, &value, sizeof(value));
+                std::vector<int> accepted;
+                std::vector<std::pair<std::string, std::shared_ptr<const std::string>>> published;
+                std::vector<std::pair<int, std::coroutine_handle<>>> resumes;
+                {
+                    std::lock_guard<std::mutex> lock(worker.pendingMutex);
+                    accepted.swap(worker.pendingFds);
+                    published.swap(worker.pendingEvents);
+                    resumes.swap(worker.pendingResumes);
+                }
+                for (const auto& entry : resumes) {
+                    auto found = worker.connections.find(entry.first);
+                    if (found == worker.connections.end()) continue;
+                    HttpConnection& conn = *found->second;
+                    resumeAsync(worker, conn, entry.second);
+                    if (conn.abandoned && !conn.task) closeConnection(entry.first);
+                }
+                if (!published.empty()) {
+                    std::vector<int> dropped;
+                    for (auto& entry : worker.connections) {
+                        HttpConnection& stream = *entry.second;
+                        if (stream.channel.empty()) continue;
+                        for (const auto& event : published) {
+                            if (event.first == stream.channel) stream.output.appendShared(event.second);
+                        }
+                        // A reader that stopped draining is cut loose rather than buffered forever
+                        if (stream.output.getSegmentCount() > MAX_STREAM_BACKLOG ||
+                            !flushConnection(worker.epollFd, stream)) {
+                            dropped.push_back(entry.first);
+                        }
+                    }
+                    for (int droppedFd : dropped) closeConnection(droppedFd);
+                }
+                for (int clientFd : accepted) addConnection(clientFd);
+                continue;
+            }
+
+            // Thread-per-core: accept on this worker's own socket
+            if (fd == worker.listenFd) {
+                while (true) {
+                    int clientFd = accept4(worker.listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (clientFd < 0) break;
+                    int one = 1;
+                    setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                    addConnection(clientFd);
+                }
+                continue;
+            }
+
+            auto it = worker.connections.find(fd);
+            if (it == worker.connections.end()) continue;
+            HttpConnection& conn = *it->second;
+            conn.lastActivity = time(nullptr);
+
+            if (events[i].events & EPOLLERR) {
+                closeConnection(fd);
+                continue;
+            }
+            if (events[i].events & EPOLLOUT) {
+                if (!flushConnection(worker.epollFd, conn)) {
+                    closeConnection(fd);
+                    continue;
+                }
+                releaseHeld(conn);
+            }
+            if (!(events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) continue;
+            if (conn.readPaused && !conn.peerClosed) {
+                // A hangup while held back: nobody is left to read the backlog
+                closeConnection(fd);
+                continue;
+            }
+
+            // Drain the socket, a bounded amount per event; level-triggered
+            // epoll reports the rest on the next pass
+            while (true) {
+                ssize_t got = recv(fd, readBuffer, sizeof(readBuffer), 0);
+                if (got > 0) {
+                    conn.inBuffer.append(readBuffer, static_cast<size_t>(got));
+                    if (conn.inBuffer.size() >= MAX_PENDING_INPUT) break;
+                } else if (got == 0) {
+                    conn.peerClosed = true;
+                    break;
+                } else if (errno == EINTR) {
+                    continue;
+                } else {
+                    if (errno != EAGAIN && errno != EWOULDBLOCK) conn.peerClosed = true;
+                    break;
+                }
+            }
+            if (!conn.channel.empty()) {
+                conn.inBuffer.clear();
+                if (conn.peerClosed) conn.closeAfterWrite = true;
+            }
+            if (conn.peerClosed && !conn.readPaused) {
+                // Hangups are level-triggered; stop watching input once it has ended
+                conn.readPaused = true;
+                watch(worker.epollFd, conn, conn.wantWrite);
+            }
+            scheduleNext(worker, conn);
+        }
+
+        // Run this pass's requests, then write everything out once
+        processQueues(worker);
+        for (int fd : worker.touched) {
+            auto it = worker.connections.find(fd);
+            if (it == worker.connections.end()) continue;
+            it->second->touched = false;
+            if (!flushConnection(worker.epollFd, *it->second)) {
+                closeConnection(fd);
+            } else {
+                releaseHeld(*it->second);
+            }
+        }
+        worker.touched.clear();
+
+        // Drop idle keep-alive connections
+        time_t now = time(nullptr);
+        if (now - lastSweep >= 1) {
+            lastSweep = now;
+            std::vector<int> idle;
+            for (const auto& entry : worker.connections) {
+                if (entry.second->channel.empty() && !entry.second->task &&
+                    now - entry.second->lastActivity >= idleTimeoutSeconds) {
+                    idle.push_back(entry.first);
+                }
+            }
+            for (int fd : idle) closeConnection(fd);
+            if (threadPerCore) {
+                worker.rateLimiter.sweep(monotonicSeconds());
+            } else if (&worker == workers.front().get()) {
+                rateLimiter.sweep(monotonicSeconds());
+            }
+        }
+    }
+}
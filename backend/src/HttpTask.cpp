@@ -0,0 +1,47 @@
+#include "../include/HttpTask.h"
+
+// Empty task
+HttpTask::HttpTask() : handle(nullptr) {}
+
+// Take ownership of a coroutine frame
+HttpTask::HttpTask(std::coroutine_handle<promise_type> frame) : handle(frame) {}
+
+// HttpTask destructor (destroys the frame, finished or suspended)
+HttpTask::~HttpTask() {
+    if (handle) handle.destroy();
+}
+
+// Move constructor
+HttpTask::HttpTask(HttpTask&& other) noexcept : handle(other.handle) {
+    other.handle = nullptr;
+}
+
+// Move assignment
+HttpTask& HttpTask::operator=(HttpTask&& other) noexcept {
+    if (this != &other) {
+        if (handle) handle.destroy();
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+// Check whether a frame is held
+HttpTask::operator bool() const {
+    return handle != nullptr;
+}
+
+// Check whether the handler has run to completion
+bool HttpTask::done() const {
+    return !handle || handle.done();
+}
+
+// Get the frame's handle (to resume it)
+std::coroutine_handle<> HttpTask::getHandle() const {
+    return handle;
+}
+
+// Rethrow an exception that escaped the handler
+void HttpTask::rethrow() const {
+    if (handle && handle.promise().error) std::rethrow_exception(handle.promise().error);
+}
@@ -0,0 +1,115 @@
+#include "../include/HyperLogLog.h"
+#include <cmath>
+
+// HyperLogLog constructor
+HyperLogLog::HyperLogLog() : registers(REGISTER_COUNT, 0) {}
+
+// 64-bit hash of a key (FNV-1a followed by a splitmix64 finalizer so the
+// low and high bits are both well mixed)
+uint64_t HyperLogLog::hashKey(const std::string& key) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+// Add a key
+void HyperLogLog::add(const std::string& key) {
+    addHash(hashKey(key));
+}
+
+// Add a pre-hashed key
+void HyperLogLog::addHash(uint64_t hash) {
+    // Top bits pick the register, the rest give the rank of the first 1 bit
+    int index = static_cast<int>(hash >> (64 - PRECISION));
+    uint64_t rest = (hash << PRECISION) | (1ULL << (PRECISION - 1));
+    uint8_t rank = 1;
+    while ((rest & (1ULL << 63)) == 0) {
+        rank++;
+        rest <<= 1;
+    }
+    if (rank > registers[index]) {
+        registers[index] = rank;
+    }
+}
+
+// Merge another sketch into this one
+void HyperLogLog::merge(const HyperLogLog& other) {
+    for (int i = 0; i < REGISTER_COUNT; i++) {
+        if (other.registers[i] > registers[i]) {
+            registers[i] = other.registers[i];
+        }
+    }
+}
+
+// Reset all registers
+void HyperLogLog::clear() {
+    for (int i = 0; i < REGISTER_COUNT; i++) {
+        registers[i] = 0;
+    }
+}
+
+// Estimate number of distinct keys
+double HyperLogLog::estimate() const {
+    const double m = REGISTER_COUNT;
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+    
+    double sum = 0.0;
+    int zeros = 0;
+    for (int i = 0; i < REGISTER_COUNT; i++) {
+        sum += std::ldexp(1.0, -registers[i]);
+        if (registers[i] == 0) zeros++;
+    }
+    
+    double raw = alpha * m * m / sum;
+    
+    // Small range: linear counting is more accurate
+    if (raw <= 2.5 * m && zeros > 0) {
+        return m * std::log(m / zeros);
+    }
+    return raw;
+}
+
+// DailyDistinctCounter constructor
+DailyDistinctCounter::DailyDistinctCounter(int days)
+    : sketches(days > 0 ? days : 1), dayStarts(days > 0 ? days : 1, -1) {}
+
+// Add a key to the sketch for its day
+void DailyDistinctCounter::add(time_t timestamp, const std::string& key) {
+    time_t dayStart = timestamp - (timestamp % SECONDS_PER_DAY);
+    size_t slot = static_cast<size_t>(dayStart / SECONDS_PER_DAY) % sketches.size();
+    
+    if (dayStarts[slot] != dayStart) {
+        // Slot holds a newer day than this sample: too old to record
+        if (dayStarts[slot] > dayStart) return;
+        sketches[slot].clear();
+        dayStarts[slot] = dayStart;
+    }
+    sketches[slot].add(key);
+}
+
+// Merge the daily sketches for a range of days
+void DailyDistinctCounter::mergeInto(HyperLogLog& target, time_t now, int days) const {
+    if (days > static_cast<int>(sketches.size())) days = static_cast<int>(sketches.size());
+    
+    time_t today = now - (now % SECONDS_PER_DAY);
+    for (int d = 0; d < days; d++) {
+        time_t dayStart = today - static_cast<time_t>(d) * SECONDS_PER_DAY;
+        size_t slot = static_cast<size_t>(dayStart / SECONDS_PER_DAY) % sketches.size();
+        if (dayStarts[slot] == dayStart) {
+            target.merge(sketches[slot]);
+        }
+    }
+}
+
+// Get number of retained days
+int DailyDistinctCounter::getRetentionDays() const {
+    return static_cast<int>(sketches.size());
+}
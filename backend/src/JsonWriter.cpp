@@ -0,0 +1,188 @@
+#include "../include/JsonWriter.h"
+#include <cmath>
+
+// JsonWriter constructor
+JsonWriter::JsonWriter(std::string& buffer)
+    : out(buffer), depth(0), excessDepth(0), afterKey(false), failed(false) {
+    hasElement[0] = false;
+}
+
+// Emit a comma before every element except the first at this level
+void JsonWriter::separate() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (hasElement[depth]) {
+        out.push_back(',');
+    }
+    hasElement[depth] = true;
+}
+
+// Open an object or array
+JsonWriter& JsonWriter::open(char bracket) {
+    separate();
+    out.push_back(bracket);
+    if (depth + 1 >= MAX_DEPTH) {
+        // No separator state left for this level
+        failed = true;
+        excessDepth++;
+        return *this;
+    }
+    depth++;
+    hasElement[depth] = false;
+    return *this;
+}
+
+// Close an object or array
+JsonWriter& JsonWriter::close(char bracket) {
+    out.push_back(bracket);
+    if (excessDepth > 0) {
+        excessDepth--;
+    } else if (depth > 0) {
+        depth--;
+    } else {
+        failed = true;
+    }
+    return *this;
+}
+
+// Start an object
+JsonWriter& JsonWriter::beginObject() {
+    return open('{');
+}
+
+// End an object
+JsonWriter& JsonWriter::endObject() {
+    return close('}');
+}
+
+// Start an array
+JsonWriter& JsonWriter::beginArray() {
+    return open('[');
+}
+
+// End an array
+JsonWriter& JsonWriter::endArray() {
+    return close(']');
+}
+
+// Write an object key
+JsonWriter& JsonWriter::key(std::string_view name) {
+    separate();
+    appendString(out, name);
+    out.push_back(':');
+    afterKey = true;
+    return *this;
+}
+
+// Write a string value
+JsonWriter& JsonWriter::value(std::string_view text) {
+    separate();
+    appendString(out, text);
+    return *this;
+}
+
+// Write a C string value
+JsonWriter& JsonWriter::value(const char* text) {
+    return value(std::string_view(text ? text : ""));
+}
+
+// Write a std::string value
+JsonWriter& JsonWriter::value(const std::string& text) {
+    return value(std::string_view(text));
+}
+
+// Write a boolean value
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    out.append(flag ? "true" : "false");
+    return *this;
+}
+
+// Write a double in shortest round-trip form (null for NaN/infinity)
+JsonWriter& JsonWriter::value(double number) {
+    if (!std::isfinite(number)) return null();
+    separate();
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+    out.append(digits, result.ptr);
+    return *this;
+}
+
+// Write a double with a fixed number of decimals
+JsonWriter& JsonWriter::value(double number, int precision) {
+    if (!std::isfinite(number)) return null();
+    separate();
+    char digits[64];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number,
+                                                std::chars_format::fixed, precision);
+    if (result.ec != std::errc()) {
+        result = std::to_chars(digits, digits + sizeof(digits), number);
+    }
+    out.append(digits, result.ptr);
+    return *this;
+}
+
+// Write null
+JsonWriter& JsonWriter::null() {
+    separate();
+    out.append("null");
+    return *this;
+}
+
+// Write a pre-serialized JSON value as-is
+JsonWriter& JsonWriter::raw(std::string_view json) {
+    separate();
+    out.append(json.data(), json.size());
+    return *this;
+}
+
+// Write a fixed-precision double field
+JsonWriter& JsonWriter::field(std::string_view name, double number, int precision) {
+    key(name);
+    return value(number, precision);
+}
+
+// Get current nesting depth
+int JsonWriter::getDepth() const {
+    return depth + excessDepth;
+}
+
+// Check whether the output is known to be invalid
+bool JsonWriter::hasFailed() const {
+    return failed;
+}
+
+// Append a quoted string, escaping quotes, backslashes and control characters
+void JsonWriter::appendString(std::string& buffer, std::string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+    buffer.push_back('"');
+    
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        
+        // Copy the clean run, then the escape
+        buffer.append(text.data() + runStart, i - runStart);
+        runStart = i + 1;
+        buffer.push_back('\\');
+        switch (c) {
+            case '"': buffer.push_back('"'); break;
+            case '\\': buffer.push_back('\\'); break;
+            case '\n': buffer.push_back('n'); break;
+            case '\r': buffer.push_back('r'); break;
+            case '\t': buffer.push_back('t'); break;
+            case '\b': buffer.push_back('b'); break;
+            case '\f': buffer.push_back('f'); break;
+            default:
+                buffer.append("u00");
+                buffer.push_back(HEX[c >> 4]);
+                buffer.push_back(HEX[c & 0xF]);
+                break;
+        }
+    }
+    buffer.append(text.data() + runStart, text.size() - runStart);
+    buffer.push_back('"');
+}
@@ -0,0 +1,259 @@
+#include "../include/Metrics.h"
+#include <cstdio>
+#include <cmath>
+
+// Hand out shards round-robin as threads first record
+int assignMetricShard() {
+    static std::atomic<int> nextShard(0);
+    return nextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+}
+
+// MetricCounter constructor
+MetricCounter::MetricCounter() {
+    for (Slot& slot : slots) slot.value.store(0, std::memory_order_relaxed);
+}
+
+// Sum of all shards
+uint64_t MetricCounter::getValue() const {
+    uint64_t total = 0;
+    for (const Slot& slot : slots) total += slot.value.load(std::memory_order_relaxed);
+    return total;
+}
+
+// MetricGauge constructor
+MetricGauge::MetricGauge() : value(0) {}
+
+// Get the current value
+int64_t MetricGauge::getValue() const {
+    return value.load(std::memory_order_relaxed);
+}
+
+// MetricHistogram constructor
+MetricHistogram::MetricHistogram() {
+    for (Shard& shard : shards) {
+        for (int i = 0; i < BUCKETS; i++) shard.counts[i].store(0, std::memory_order_relaxed);
+        shard.sumNanos.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Upper bound of a bucket: 1024ns * 4^bucket
+uint64_t MetricHistogram::getUpperBoundNanos(int bucket) {
+    if (bucket < 0 || bucket >= BUCKETS - 1) return 0;
+    return 1024ULL << (2 * bucket);
+}
+
+// Samples in one bucket
+uint64_t MetricHistogram::getBucketCount(int bucket) const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards) total += shard.counts[bucket].load(std::memory_order_relaxed);
+    return total;
+}
+
+// Total samples
+uint64_t MetricHistogram::getCount() const {
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKETS; i++) total += getBucketCount(i);
+    return total;
+}
+
+// Sum of all samples in nanoseconds
+uint64_t MetricHistogram::getSumNanos() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards) total += shard.sumNanos.load(std::memory_order_relaxed);
+    return total;
+}
+
+// MetricsRegistry constructor
+MetricsRegistry::MetricsRegistry() {}
+
+// Find a series, creating its family and the series on first use
+MetricsRegistry::Series& MetricsRegistry::findOrAdd(const std::string& name, const std::string& help,
+                                                    MetricType type, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Family* family = nullptr;
+    for (auto& existing : families) {
+        if (existing->name == name) {
+            family = existing.get();
+            break;
+        }
+    }
+    if (!family) {
+        families.emplace_back(new Family());
+        family = families.back().get();
+        family->name = name;
+        family->help = help;
+        family->type = type;
+    }
+    Series* series = nullptr;
+    for (auto& existing : family->series) {
+        if (existing->labels == labels) {
+            series = existing.get();
+            break;
+        }
+    }
+    if (!series) {
+        series = new Series();
+        series->labels = labels;
+        family->series.emplace_back(series);
+    }
+
+    // A name registered with another type still gets something to record
+    // into, but the exposition only renders the family's own type
+    switch (type) {
+        case METRIC_COUNTER:
+            if (!series->counter) series->counter.reset(new MetricCounter());
+            break;
+        case METRIC_GAUGE:
+            if (!series->gauge) series->gauge.reset(new MetricGauge());
+            break;
+        case METRIC_HISTOGRAM:
+            if (!series->histogram) series->histogram.reset(new MetricHistogram());
+            break;
+    }
+    return *series;
+}
+
+// Get or register a counter
+MetricCounter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                        const std::string& labels) {
+    return *findOrAdd(name, help, METRIC_COUNTER, labels).counter;
+}
+
+// Get or register a gauge
+MetricGauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                                    const std::string& labels) {
+    return *findOrAdd(name, help, METRIC_GAUGE, labels).gauge;
+}
+
+// Get or register a latency histogram
+MetricHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                            const std::string& labels) {
+    return *findOrAdd(name, help, METRIC_HISTOGRAM, labels).histogram;
+}
+
+// Format a sample value; integers print without an exponent
+static void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        snprintf(buffer, sizeof(buffer), "%.0f", value);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%.12g", value);
+    }
+    out += buffer;
+}
+
+// Join a series' labels with one more label
+static std::string withLabel(const std::string& labels, const std::string& extra) {
+    return labels.empty() ? extra : labels + "," + extra;
+}
+
+// Render name="value" with Prometheus escaping
+std::string MetricsRegistry::label(const std::string& name, const std::string& value) {
+    std::string out = name + "=\"";
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+    return out;
+}
+
+// Write the HELP and TYPE lines of a family
+static void writeHeader(std::string& out, const std::string& name, const std::string& help,
+                        const char* type) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    for (char c : help) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+// Write one sample line
+static void writeSample(std::string& out, const std::string& name, const std::string& labels,
+                        double value) {
+    out += name;
+    if (!labels.empty()) {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+    out += ' ';
+    appendNumber(out, value);
+    out += '\n';
+}
+
+// Render every family
+void MetricsRegistry::writePrometheus(std::string& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& family : families) {
+        const std::string& name = family->name;
+        switch (family->type) {
+            case METRIC_COUNTER:
+                writeHeader(out, name, family->help, "counter");
+                for (const auto& series : family->series) {
+                    if (series->counter) {
+                        writeSample(out, name, series->labels, static_cast<double>(series->counter->getValue()));
+                    }
+                }
+                break;
+            case METRIC_GAUGE:
+                writeHeader(out, name, family->help, "gauge");
+                for (const auto& series : family->series) {
+                    if (series->gauge) {
+                        writeSample(out, name, series->labels, static_cast<double>(series->gauge->getValue()));
+                    }
+                }
+                break;
+            case METRIC_HISTOGRAM:
+                writeHeader(out, name, family->help, "histogram");
+                for (const auto& series : family->series) {
+                    if (!series->histogram) continue;
+                    const MetricHistogram& histogram = *series->histogram;
+                    uint64_t cumulative = 0;
+                    for (int i = 0; i < MetricHistogram::BUCKETS; i++) {
+                        cumulative += histogram.getBucketCount(i);
+                        std::string le = "+Inf";
+                        if (i < MetricHistogram::BUCKETS - 1) {
+                            char bound[32];
+                            snprintf(bound, sizeof(bound), "%.12g",
+                                     MetricHistogram::getUpperBoundNanos(i) / 1e9);
+                            le = bound;
+                        }
+                        writeSample(out, name + "_bucket", withLabel(series->labels, label("le", le)),
+                                    static_cast<double>(cumulative));
+                    }
+                    writeSample(out, name + "_sum", series->labels, histogram.getSumNanos() / 1e9);
+                    writeSample(out, name + "_count", series->labels, static_cast<double>(cumulative));
+                }
+                break;
+        }
+    }
+}
+
+// Get number of registered families
+size_t MetricsRegistry::getFamilyCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return families.size();
+}
+
+// Process-wide registry (constructed on first use, never destroyed, so
+// static objects such as a global ParkingSystem can still update their
+// metrics from their destructors at exit)
+MetricsRegistry& metrics() {
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
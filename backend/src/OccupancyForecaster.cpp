@@ -0,0 +1,77 @@
+#include "../include/OccupancyForecaster.h"
+#include <cmath>
+
+// OccupancyForecaster constructor
+OccupancyForecaster::OccupancyForecaster(double levelAlpha, double trendBeta,
+                                         double seasonGamma, double trendDamping)
+    : alpha(levelAlpha), beta(trendBeta), gamma(seasonGamma), phi(trendDamping),
+      level(0.0), trend(0.0), initialized(false), lastUpdate(0), sampleCount(0) {
+    for (int i = 0; i < SEASON_SLOTS; i++) {
+        seasonal[i] = 0.0;
+    }
+}
+
+// Seasonal slot for a timestamp
+int OccupancyForecaster::slotFor(time_t timestamp) {
+    return static_cast<int>((timestamp % (24 * 60 * 60)) / SLOT_SECONDS);
+}
+
+// Fold one occupancy sample into level, trend and season
+void OccupancyForecaster::update(time_t timestamp, double occupancy) {
+    int slot = slotFor(timestamp);
+    double season = seasonal[slot];
+    
+    if (!initialized) {
+        level = occupancy;
+        trend = 0.0;
+        initialized = true;
+    } else {
+        double minutes = static_cast<double>(timestamp - lastUpdate) / 60.0;
+        if (minutes < 0.0) minutes = 0.0;
+        
+        double damping = std::pow(phi, minutes);
+        double expectedLevel = level + trend * minutes * damping;
+        double newLevel = alpha * (occupancy - season) + (1.0 - alpha) * expectedLevel;
+        if (minutes > 0.0) {
+            trend = beta * ((newLevel - level) / minutes) + (1.0 - beta) * trend * damping;
+        }
+        level = newLevel;
+    }
+    
+    seasonal[slot] = gamma * (occupancy - level) + (1.0 - gamma) * season;
+    lastUpdate = timestamp;
+    sampleCount++;
+}
+
+// Predict occupancy fraction minutesAhead after now
+double OccupancyForecaster::forecast(time_t now, int minutesAhead) const {
+    if (!initialized) return 0.0;
+    
+    double horizon = static_cast<double>(now - lastUpdate) / 60.0 + minutesAhead;
+    if (horizon < 0.0) horizon = 0.0;
+    
+    // Damped trend: sum of phi^k for k = 1..horizon
+    double trendFactor = (phi < 1.0) ? phi * (1.0 - std::pow(phi, horizon)) / (1.0 - phi) : horizon;
+    double predicted = level + trend * trendFactor +
+                       seasonal[slotFor(now + static_cast<time_t>(minutesAhead) * 60)];
+    
+    if (predicted < 0.0) return 0.0;
+    if (predicted > 1.0) return 1.0;
+    return predicted;
+}
+
+// Predict free slots minutesAhead after now
+int OccupancyForecaster::forecastFreeSlots(int totalSlots, time_t now, int minutesAhead) const {
+    double free = totalSlots * (1.0 - forecast(now, minutesAhead));
+    return static_cast<int>(std::floor(free + 1e-9));
+}
+
+// Check whether enough samples were seen (10 minutes of 1-per-minute ticks)
+bool OccupancyForecaster::isReady() const {
+    return sampleCount >= 10;
+}
+
+// Get number of samples seen
+long long OccupancyForecaster::getSampleCount() const {
+    return sampleCount;
+}
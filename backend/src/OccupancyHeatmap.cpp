@@ -0,0 +1,105 @@
+#include "../include/OccupancyHeatmap.h"
+#include "../include/JsonWriter.h"
+#include <cmath>
+
+// Binary cell value for hours without samples
+static const uint16_t EMPTY_CELL = 0xFFFF;
+
+// Append a little-endian u16
+static void appendU16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+// OccupancyHeatmap constructor
+OccupancyHeatmap::OccupancyHeatmap(const std::vector<std::string>& zones)
+    : zoneIds(zones), sums(zones.size() * HOURS_PER_WEEK, 0.0),
+      counts(zones.size() * HOURS_PER_WEEK, 0) {}
+
+// Hour of week for a timestamp (the epoch fell on a Thursday)
+int OccupancyHeatmap::hourOfWeek(time_t timestamp) {
+    long long hours = static_cast<long long>(timestamp) / 3600 + 3 * 24;
+    int hour = static_cast<int>(hours % HOURS_PER_WEEK);
+    return hour < 0 ? hour + HOURS_PER_WEEK : hour;
+}
+
+// Fold one occupancy sample (percent) into its cell
+void OccupancyHeatmap::addSample(int zoneIndex, time_t timestamp, double occupancy) {
+    if (zoneIndex < 0 || zoneIndex >= getZoneCount()) return;
+    size_t cell = static_cast<size_t>(zoneIndex) * HOURS_PER_WEEK + hourOfWeek(timestamp);
+    sums[cell] += occupancy;
+    counts[cell]++;
+}
+
+// Get average occupancy of a cell
+double OccupancyHeatmap::getAverage(int zoneIndex, int hour) const {
+    uint32_t n = getCount(zoneIndex, hour);
+    if (n == 0) return -1.0;
+    return sums[static_cast<size_t>(zoneIndex) * HOURS_PER_WEEK + hour] / n;
+}
+
+// Get number of samples in a cell
+uint32_t OccupancyHeatmap::getCount(int zoneIndex, int hour) const {
+    if (zoneIndex < 0 || zoneIndex >= getZoneCount() || hour < 0 || hour >= HOURS_PER_WEEK) {
+        return 0;
+    }
+    return counts[static_cast<size_t>(zoneIndex) * HOURS_PER_WEEK + hour];
+}
+
+// Get number of zones
+int OccupancyHeatmap::getZoneCount() const {
+    return static_cast<int>(zoneIds.size());
+}
+
+// Serialize averages as JSON
+std::string OccupancyHeatmap::toJson() const {
+    std::string out;
+    out.reserve(32 + zoneIds.size() * (32 + HOURS_PER_WEEK * 5));
+    JsonWriter writer(out);
+    writer.beginObject().field("hours", static_cast<int>(HOURS_PER_WEEK));
+    writer.key("zones").beginArray();
+    for (int z = 0; z < getZoneCount(); z++) {
+        writer.beginObject().field("zoneId", zoneIds[z]);
+        writer.key("average").beginArray();
+        for (int h = 0; h < HOURS_PER_WEEK; h++) {
+            double average = getAverage(z, h);
+            if (average < 0.0) {
+                writer.null();
+            } else {
+                writer.value(average, 1);
+            }
+        }
+        writer.endArray().endObject();
+    }
+    writer.endArray().endObject();
+    return out;
+}
+
+// Serialize averages in the compact binary layout
+std::string OccupancyHeatmap::toBinary() const {
+    std::string out;
+    out.reserve(10 + zoneIds.size() * (16 + HOURS_PER_WEEK * 2));
+    out.append("NPHM", 4);
+    appendU16(out, 1);
+    appendU16(out, static_cast<uint16_t>(zoneIds.size()));
+    appendU16(out, HOURS_PER_WEEK);
+    
+    for (const std::string& id : zoneIds) {
+        size_t length = id.size() > 255 ? 255 : id.size();
+        out.push_back(static_cast<char>(length));
+        out.append(id, 0, length);
+    }
+    
+    for (int z = 0; z < getZoneCount(); z++) {
+        for (int h = 0; h < HOURS_PER_WEEK; h++) {
+            double average = getAverage(z, h);
+            if (average < 0.0) {
+                appendU16(out, EMPTY_CELL);
+            } else {
+                double clamped = std::fmin(std::fmax(average, 0.0), 100.0);
+                appendU16(out, static_cast<uint16_t>(std::lround(clamped * 100.0)));
+            }
+        }
+    }
+    return out;
+}
@@ -0,0 +1,105 @@
+#include "../include/OccupancySeries.h"
+#include <algorithm>
+
+// OccupancyBucket constructor
+OccupancyBucket::OccupancyBucket()
+    : start(-1), samples(0), sum(0.0), min(0.0), max(0.0) {}
+
+// Get average occupancy in the bucket
+double OccupancyBucket::getAverage() const {
+    if (samples == 0) return 0.0;
+    return sum / samples;
+}
+
+// OccupancyRing constructor
+OccupancyRing::OccupancyRing(int secondsPerBucket, int capacity)
+    : buckets(capacity > 0 ? capacity : 1), bucketSeconds(secondsPerBucket > 0 ? secondsPerBucket : 1),
+      newestStart(-1) {}
+
+// Add a sample to the bucket covering the timestamp
+void OccupancyRing::add(time_t timestamp, double value) {
+    time_t bucketStart = timestamp - (timestamp % bucketSeconds);
+    
+    // Ignore samples that fall before the retained window
+    if (newestStart >= 0 &&
+        bucketStart <= newestStart - static_cast<time_t>(buckets.size()) * bucketSeconds) {
+        return;
+    }
+    if (bucketStart > newestStart) newestStart = bucketStart;
+    
+    OccupancyBucket& bucket = buckets[(bucketStart / bucketSeconds) % buckets.size()];
+    
+    // Slot still holds an older bucket: recycle it
+    if (bucket.start != bucketStart) {
+        bucket = OccupancyBucket();
+        bucket.start = bucketStart;
+        bucket.min = value;
+        bucket.max = value;
+    }
+    
+    bucket.samples++;
+    bucket.sum += value;
+    bucket.min = std::min(bucket.min, value);
+    bucket.max = std::max(bucket.max, value);
+}
+
+// Get buckets in [from, to], oldest first
+std::vector<OccupancyBucket> OccupancyRing::query(time_t from, time_t to) const {
+    std::vector<OccupancyBucket> result;
+    if (to < from || newestStart < 0) return result;
+    
+    time_t first = from - (from % bucketSeconds);
+    time_t last = to - (to % bucketSeconds);
+    if (last > newestStart) last = newestStart;
+    
+    // Anything older than one full ring has been overwritten
+    time_t oldest = newestStart - static_cast<time_t>(buckets.size() - 1) * bucketSeconds;
+    if (first < oldest) first = oldest;
+    
+    for (time_t t = first; t <= last; t += bucketSeconds) {
+        const OccupancyBucket& bucket = buckets[(t / bucketSeconds) % buckets.size()];
+        if (bucket.start == t) {
+            result.push_back(bucket);
+        }
+    }
+    return result;
+}
+
+// Get bucket width
+int OccupancyRing::getBucketSeconds() const {
+    return bucketSeconds;
+}
+
+// Get number of buckets
+int OccupancyRing::getCapacity() const {
+    return static_cast<int>(buckets.size());
+}
+
+// OccupancySeries constructor
+OccupancySeries::OccupancySeries()
+    : minuteRing(60, 24 * 60),
+      quarterRing(15 * 60, 7 * 24 * 4),
+      hourRing(60 * 60, 90 * 24) {}
+
+// Select ring for a resolution
+const OccupancyRing& OccupancySeries::ringFor(SeriesResolution resolution) const {
+    switch (resolution) {
+        case RESOLUTION_15_MINUTES: return quarterRing;
+        case RESOLUTION_HOUR: return hourRing;
+        case RESOLUTION_MINUTE:
+        default: return minuteRing;
+    }
+}
+
+// Record an occupancy sample (percentage) at all resolutions
+void OccupancySeries::recordSample(time_t timestamp, double occupancy) {
+    minuteRing.add(timestamp, occupancy);
+    quarterRing.add(timestamp, occupancy);
+    hourRing.add(timestamp, occupancy);
+}
+
+// Query buckets in a time range at a resolution
+std::vector<OccupancyBucket> OccupancySeries::query(time_t from, time_t to,
+                                                    SeriesResolution resolution) const {
+    return ringFor(resolution).query(from, to);
+}
@@ -1,4 +1,5 @@
 ﻿#include "../include/ParkingRequest.h"
+#include "../include/JsonWriter.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -6,10 +7,11 @@
 // ParkingRequest constructor
 ParkingRequest::ParkingRequest(const std::string& reqId, 
                                const std::string& vehicle, 
-                               const std::string& zone)
+                               const std::string& zone,
+                               VehicleType type)
     : requestId(reqId), vehicleId(vehicle), preferredZone(zone),
       allocatedZone(""), slotId(""), currentState(REQUESTED),
-      durationHours(0), totalCost(0.0), isCrossZone(false) {
+      durationHours(0), vehicleType(type), totalCost(0.0), isCrossZone(false), observer(nullptr) {
     requestTime = time(nullptr);
     allocationTime = 0;
     completionTime = 0;
@@ -24,6 +26,7 @@ bool ParkingRequest::allocate(const std::string& zone, const std::string& slot,
         return false;
     }
     
+    RequestState previousState = currentState;
     allocatedZone = zone;
     slotId = slot;
     totalCost = cost;
@@ -31,6 +34,7 @@ bool ParkingRequest::allocate(const std::string& zone, const std::string& slot,
     currentState = ALLOCATED;
     allocationTime = time(nullptr);
     
+    notifyTransition(previousState);
     return true;
 }
 
@@ -42,7 +46,9 @@ bool ParkingRequest::occupy() {
         return false;
     }
     
+    RequestState previousState = currentState;
     currentState = OCCUPIED;
+    notifyTransition(previousState);
     return true;
 }
 
@@ -54,8 +60,10 @@ bool ParkingRequest::release() {
         return false;
     }
     
+    RequestState previousState = currentState;
     currentState = RELEASED;
     completionTime = time(nullptr);
+    notifyTransition(previousState);
     return true;
 }
 
@@ -67,8 +75,10 @@ bool ParkingRequest::cancel() {
         return false;
     }
     
+    RequestState previousState = currentState;
     currentState = CANCELLED;
     completionTime = time(nullptr);
+    notifyTransition(previousState);
     return true;
 }
 
@@ -93,6 +103,28 @@ bool ParkingRequest::isValidTransition(RequestState newState) const {
     }
 }
 
+// Notify observer of a completed transition
+void ParkingRequest::notifyTransition(RequestState previousState) {
+    if (observer) {
+        observer->onRequestTransition(*this, previousState);
+    }
+}
+
+// Set booked duration
+void ParkingRequest::setDurationHours(int hours) {
+    durationHours = hours > 0 ? hours : 0;
+}
+
+// Set transition observer
+void ParkingRequest::setObserver(RequestObserver* obs) {
+    observer = obs;
+}
+
+// Get transition observer
+RequestObserver* ParkingRequest::getObserver() const {
+    return observer;
+}
+
 // Get request ID
 std::string ParkingRequest::getRequestId() const {
     return requestId;
@@ -155,6 +187,11 @@ double ParkingRequest::getDuration() const {
     return durationHours;
 }
 
+// Get vehicle type
+VehicleType ParkingRequest::getVehicleType() const {
+    return vehicleType;
+}
+
 // Get total cost
 double ParkingRequest::getTotalCost() const {
     return totalCost;
@@ -192,3 +229,22 @@ std::string ParkingRequest::getDetailedInfo() const {
     
     return ss.str();
 }
+
+// Serialize as a JSON object
+void ParkingRequest::writeJson(JsonWriter& writer) const {
+    writer.beginObject()
+          .field("requestId", requestId)
+          .field("vehicleId", vehicleId)
+          .field("vehicleType", getVehicleTypeInfo(vehicleType).name)
+          .field("preferredZone", preferredZone)
+          .field("allocatedZone", allocatedZone)
+          .field("slotId", slotId)
+          .field("state", getStateString())
+          .field("requestTime", static_cast<long long>(requestTime))
+          .field("allocationTime", static_cast<long long>(allocationTime))
+          .field("completionTime", static_cast<long long>(completionTime))
+          .field("durationHours", getDuration())
+          .field("totalCost", totalCost, 2)
+          .field("crossZone", isCrossZone)
+          .endObject();
+}
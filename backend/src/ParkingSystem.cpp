@@ -3,16 +3,18 @@
 #include <iomanip>
 #include <sstream>
 #include <ctime>
+#include <cstdio>
 #include <algorithm>
 #include <random>
 
 using namespace std;
 
 // Constructor
-ParkingSystem::ParkingSystem() : zoneCount(0), zones(nullptr) {
+ParkingSystem::ParkingSystem() : zoneCount(0), zones(nullptr), nextRequestNumber(1) {
     allocator = nullptr;
     rollbackManager = new RollbackManager(10);
     analytics = nullptr;
+    zoneStatus = nullptr;
     
     // Initialize random number generator for demo
     srand(time(nullptr));
@@ -20,6 +22,8 @@ ParkingSystem::ParkingSystem() : zoneCount(0), zones(nullptr) {
 
 // Destructor
 ParkingSystem::~ParkingSystem() {
+    delete zoneStatus;
+    
     // Delete all zones
     for (int i = 0; i < zoneCount; i++) {
         delete zones[i];
@@ -62,9 +66,25 @@ void ParkingSystem::initializeZones() {
     // Zone E - Airport Parking
     zones[4] = new Zone("ZE", "Airport Parking E", 30, 8.0);
     
+    // Road links between zones (metres); overflow allocation routes over these
+    const struct { int from, to, distance; } roads[] = {
+        {0, 1, 500}, {0, 2, 800}, {1, 2, 300}, {1, 3, 700}, {2, 4, 400}, {3, 4, 600}
+    };
+    for (const auto& road : roads) {
+        zones[road.from]->addConnection(new ZoneConnection(zones[road.to]->getZoneId(), road.distance));
+        zones[road.to]->addConnection(new ZoneConnection(zones[road.from]->getZoneId(), road.distance));
+    }
+    
+    for (int i = 0; i < zoneCount; i++) {
+        zoneIndex[zones[i]->getZoneId()] = zones[i];
+    }
+    
     // Initialize allocation engine with zones
     allocator = new AllocationEngine(zones, zoneCount);
     
+    // Pre-serialize the zone list served by /api/zones
+    zoneStatus = new ZoneStatusBuffer(zones, zoneCount);
+    
     // Create sample vehicles for demo
     addVehicle(new Vehicle("CAR001", "ZA", CAR));
     addVehicle(new Vehicle("BIKE001", "ZB", BIKE));
@@ -86,67 +106,187 @@ void ParkingSystem::addZone(Zone* zone) {
 // Add a vehicle to the system
 void ParkingSystem::addVehicle(Vehicle* vehicle) {
     vehicles.push_back(vehicle);
+    vehicleIndex[vehicle->getVehicleId()] = vehicle;
 }
 
 // Find vehicle by ID
-Vehicle* ParkingSystem::findVehicle(const std::string& vehicleId) const {
-    for (auto vehicle : vehicles) {
-        if (vehicle->getVehicleId() == vehicleId) {
-            return vehicle;
-        }
-    }
-    return nullptr;
+Vehicle* ParkingSystem::findVehicle(std::string_view vehicleId) const {
+    auto it = vehicleIndex.find(vehicleId);
+    return it != vehicleIndex.end() ? it->second : nullptr;
 }
 
 // Find request by ID
-ParkingRequest* ParkingSystem::findRequest(const std::string& requestId) const {
-    for (auto request : requests) {
-        if (request->getRequestId() == requestId) {
-            return request;
-        }
-    }
-    return nullptr;
+ParkingRequest* ParkingSystem::findRequest(std::string_view requestId) const {
+    auto it = requestIndex.find(requestId);
+    return it != requestIndex.end() ? it->second : nullptr;
 }
 
 // Find zone by ID
-Zone* ParkingSystem::findZone(const std::string& zoneId) const {
-    for (int i = 0; i < zoneCount; i++) {
-        if (zones[i]->getZoneId() == zoneId) {
-            return zones[i];
-        }
-    }
-    return nullptr;
+Zone* ParkingSystem::findZone(std::string_view zoneId) const {
+    auto it = zoneIndex.find(zoneId);
+    return it != zoneIndex.end() ? it->second : nullptr;
+}
+
+// Check whether a zone exists
+bool ParkingSystem::hasZone(std::string_view zoneId) const {
+    return findZone(zoneId) != nullptr;
+}
+
+// Get a request by ID (nullptr if unknown)
+const ParkingRequest* ParkingSystem::getRequest(std::string_view requestId) const {
+    return findRequest(requestId);
 }
 
 // Update analytics with current data
 void ParkingSystem::updateAnalytics() {
-    // Stub implementation - will be completed when Analytics.cpp is created
+    // Analytics tracks requests incrementally; rebuilding it re-seeds the counters
+    delete analytics;
+    analytics = new Analytics(requests.data(), static_cast<int>(requests.size()),
+                              zones, zoneCount);
+    analytics->setAlertCallback(alertCallback);
+    
+    // Let the allocator steer overflow away from zones about to fill
+    if (allocator) {
+        allocator->setForecasters(analytics->getForecasters(), 15);
+    }
 }
 
 // Main function to request parking
-std::string ParkingSystem::requestParking(const std::string& vehicleId, 
-                                         const std::string& preferredZone,
+std::string ParkingSystem::requestParking(std::string_view vehicleId,
+                                         std::string_view preferredZone,
                                          int durationHours) {
-    // Stub implementation
-    return "";
+    Zone* zone = findZone(preferredZone);
+    if (!zone || !allocator || durationHours <= 0) {
+        return "";
+    }
+    if (analytics) {
+        analytics->recordArrival(zone->getZoneId());
+    }
+    
+    // First request from a vehicle registers it
+    Vehicle* vehicle = findVehicle(vehicleId);
+    if (!vehicle) {
+        vehicle = new Vehicle(std::string(vehicleId), zone->getZoneId(), CAR);
+        addVehicle(vehicle);
+    }
+    
+    char idBuffer[16];
+    snprintf(idBuffer, sizeof(idBuffer), "REQ%03d", nextRequestNumber);
+    ParkingRequest* request = new ParkingRequest(idBuffer, vehicle->getVehicleId(),
+                                                 zone->getZoneId(), vehicle->getVehicleType());
+    
+    std::string allocatedZone, allocatedSlot;
+    std::vector<std::string> path;
+    double cost = 0.0;
+    if (!allocator->allocateParking(request, vehicle, durationHours,
+                                    allocatedZone, allocatedSlot, path, cost)) {
+        delete request;
+        return "";
+    }
+    
+    nextRequestNumber++;
+    requests.push_back(request);
+    requestIndex[request->getRequestId()] = request;
+    if (analytics) {
+        analytics->trackRequest(request);
+    }
+    rollbackManager->pushOperation(new RollbackOperation(OP_ALLOCATE, request->getRequestId(),
+                                                         allocatedZone, allocatedSlot, REQUESTED));
+    return request->getRequestId();
 }
 
-// Cancel a parking request
-bool ParkingSystem::cancelParking(const std::string& requestId) {
-    // Stub implementation
-    return false;
+// Cancel a parking request, returning its slot if one was allocated
+bool ParkingSystem::cancelParking(std::string_view requestId) {
+    ParkingRequest* request = findRequest(requestId);
+    if (!request || !request->isValidTransition(CANCELLED)) {
+        return false;
+    }
+    
+    RequestState previousState = request->getState();
+    request->cancel();
+    Zone* zone = previousState == ALLOCATED ? findZone(request->getAllocatedZone()) : nullptr;
+    if (zone) {
+        zone->releaseSlot();
+    }
+    rollbackManager->pushOperation(new RollbackOperation(OP_CANCEL, request->getRequestId(),
+                                                         request->getAllocatedZone(),
+                                                         zone ? request->getSlotId() : "",
+                                                         previousState));
+    return true;
 }
 
 // Occupy a parking slot (user arrives)
-bool ParkingSystem::occupyParking(const std::string& requestId) {
-    // Stub implementation
-    return false;
+bool ParkingSystem::occupyParking(std::string_view requestId) {
+    ParkingRequest* request = findRequest(requestId);
+    if (!request || !request->isValidTransition(OCCUPIED)) {
+        return false;
+    }
+    return request->occupy();
 }
 
 // Release a parking slot (user leaves)
-bool ParkingSystem::releaseParking(const std::string& requestId) {
-    // Stub implementation
-    return false;
+bool ParkingSystem::releaseParking(std::string_view requestId) {
+    ParkingRequest* request = findRequest(requestId);
+    if (!request || !request->isValidTransition(RELEASED)) {
+        return false;
+    }
+    
+    request->release();
+    if (Zone* zone = findZone(request->getAllocatedZone())) {
+        zone->releaseSlot();
+    }
+    rollbackManager->pushOperation(new RollbackOperation(OP_RELEASE, request->getRequestId(),
+                                                         request->getAllocatedZone(),
+                                                         request->getSlotId(), OCCUPIED));
+    return true;
+}
+
+// Apply a batch of operations in order
+int ParkingSystem::executeBatch(const std::vector<BatchOperation>& operations, JsonWriter& writer) {
+    int succeeded = 0;
+    writer.beginArray();
+    for (size_t i = 0; i < operations.size(); i++) {
+        const BatchOperation& op = operations[i];
+        writer.beginObject().field("index", static_cast<int>(i)).field("op", op.opName);
+        
+        std::string_view error;
+        if (op.type == BATCH_INVALID) {
+            error = op.error;
+        } else if (op.type == BATCH_REQUEST) {
+            std::string requestId = requestParking(op.vehicleId, op.preferredZone, op.durationHours);
+            if (!requestId.empty()) {
+                const ParkingRequest* request = getRequest(requestId);
+                writer.field("requestId", requestId)
+                      .field("allocatedZone", request->getAllocatedZone())
+                      .field("totalCost", request->getTotalCost(), 2);
+            } else {
+                error = hasZone(op.preferredZone) ? "No parking available" : "Unknown zone";
+            }
+        } else {
+            const ParkingRequest* request = getRequest(op.requestId);
+            bool done = op.type == BATCH_OCCUPY ? occupyParking(op.requestId) :
+                        op.type == BATCH_RELEASE ? releaseParking(op.requestId) :
+                        cancelParking(op.requestId);
+            if (!request) {
+                error = "Request not found";
+            } else if (done) {
+                writer.field("requestId", op.requestId).field("state", request->getStateString());
+            } else {
+                error = "Invalid transition from current state";
+                writer.field("state", request->getStateString());
+            }
+        }
+        
+        writer.field("success", error.empty());
+        if (error.empty()) {
+            succeeded++;
+        } else {
+            writer.field("error", error);
+        }
+        writer.endObject();
+    }
+    writer.endArray();
+    return succeeded;
 }
 
 // Undo last operation
@@ -163,7 +303,11 @@ bool ParkingSystem::undoOperations(int steps) {
 
 // Display analytics
 void ParkingSystem::displayAnalytics() const {
-    cout << "Analytics display - to be implemented" << endl;
+    if (!analytics) {
+        cout << "Analytics not initialized" << endl;
+        return;
+    }
+    analytics->displayDetailedReport();
 }
 
 // Display zone status
@@ -176,6 +320,111 @@ void ParkingSystem::displayAllRequests() const {
     cout << "All requests display - to be implemented" << endl;
 }
 
+// Sample zone occupancy into the analytics time series
+void ParkingSystem::recordOccupancySample() {
+    recordOccupancySample(time(nullptr));
+}
+
+// Sample zone occupancy as of a given time (feeds the series, forecasters,
+// heatmap and anomaly detectors)
+void ParkingSystem::recordOccupancySample(time_t now) {
+    if (analytics) {
+        analytics->sampleOccupancy(now);
+    }
+}
+
+// Feed the anomaly detectors without taking an occupancy sample
+void ParkingSystem::checkAnomalies() {
+    if (analytics) {
+        analytics->checkAnomalies(time(nullptr));
+    }
+}
+
+// Get analytics state version (0 before initialization)
+uint64_t ParkingSystem::getStateVersion() const {
+    return analytics ? analytics->getStateVersion() : 0;
+}
+
+// Get cached analytics JSON payload
+std::string ParkingSystem::getAnalyticsJson() const {
+    return analytics ? analytics->generateReportJson() : "{}";
+}
+
+// Rebuild stale analytics payloads ahead of the next API read
+void ParkingSystem::refreshAnalytics() const {
+    if (analytics) {
+        analytics->refreshCachedReports();
+    }
+}
+
+// Set the function called for each anomaly alert
+void ParkingSystem::setAlertCallback(AnomalyCallback callback) {
+    alertCallback = callback;
+    if (analytics) {
+        analytics->setAlertCallback(callback);
+    }
+}
+
+// Get recent anomaly alerts as a JSON array
+std::string ParkingSystem::getAlertsJson(int maxAlerts) const {
+    return analytics ? analytics->getRecentAlertsJson(maxAlerts) : "[]";
+}
+
+// Get hour-of-week occupancy heatmap as JSON
+std::string ParkingSystem::getHeatmapJson() const {
+    return analytics ? analytics->getHeatmapJson() : "{}";
+}
+
+// Get the live zone list JSON
+const std::string& ParkingSystem::getZonesJson() const {
+    static const std::string empty = "[]";
+    return zoneStatus ? zoneStatus->getJson() : empty;
+}
+
+// Write the zones changed after a client's version
+void ParkingSystem::writeZonesSince(JsonWriter& writer, uint64_t since) const {
+    uint64_t current = Zone::getCurrentVersion();
+    int changed = 0;
+    for (int i = 0; i < zoneCount; i++) {
+        if (zones[i]->getVersion() > since) changed++;
+    }
+    
+    // Version 0 or one from the future (server restart) means no baseline;
+    // past half the zones a delta saves too little to be worth it
+    bool full = since == 0 || since > current || changed * 2 > zoneCount;
+    writer.beginObject()
+          .field("version", current)
+          .field("full", full)
+          .field("changed", full ? zoneCount : changed);
+    writer.key("zones");
+    if (full) {
+        writer.raw(getZonesJson());
+    } else {
+        writer.beginArray();
+        for (int i = 0; i < zoneCount; i++) {
+            if (zones[i]->getVersion() > since) {
+                ZoneStatusBuffer::writeDelta(writer, *zones[i]);
+            }
+        }
+        writer.endArray();
+    }
+    writer.endObject();
+}
+
+// Get the latest zone change version
+uint64_t ParkingSystem::getZoneVersion() const {
+    return Zone::getCurrentVersion();
+}
+
+// Drain coalesced availability changes as a JSON array
+int ParkingSystem::takeZoneDeltas(std::string& out) {
+    if (!zoneStatus) {
+        out += "[]";
+        return 0;
+    }
+    return zoneStatus->takeChanges(out);
+}
+
 // Get total available slots
 int ParkingSystem::getTotalAvailableSlots() const {
     return 0;
@@ -1,4 +1,5 @@
 ﻿#include "../include/PathFinder.h"
+#include "../include/Metrics.h"
 #include <iostream>
 #include <limits>
 #include <algorithm>
@@ -48,11 +49,11 @@ void MinHeap::heapifyDown(int index) {
     int left = 2 * index + 1;
     int right = 2 * index + 2;
     
-    if (left < heapSize && *heap[left] > *heap[smallest]) {
+    if (left < heapSize && *heap[smallest] > *heap[left]) {
         smallest = left;
     }
     
-    if (right < heapSize && *heap[right] > *heap[smallest]) {
+    if (right < heapSize && *heap[smallest] > *heap[right]) {
         smallest = right;
     }
     
@@ -69,6 +70,7 @@ void MinHeap::heapifyDown(int index) {
 void MinHeap::push(PathNode* node) {
     if (heapSize >= capacity) {
         // Resize heap (simplified)
+        delete node;
         return;
     }
     
@@ -94,6 +96,14 @@ bool MinHeap::isEmpty() const {
     return heapSize == 0;
 }
 
+// Delete all queued nodes
+void MinHeap::clear() {
+    for (int i = 0; i < heapSize; i++) {
+        delete heap[i];
+    }
+    heapSize = 0;
+}
+
 // Update distance of a node
 void MinHeap::updateDistance(const std::string& zoneId, int newDistance, const std::string& previous) {
     // Find the node
@@ -124,8 +134,16 @@ std::vector<std::string> PathFinder::findShortestPath(
     Zone** allZones,
     int zoneCount
 ) {
+    static MetricHistogram& latency = metrics().histogram(
+        "nexuspark_pathfinder_duration_seconds", "Time spent in PathFinder queries",
+        MetricsRegistry::label("query", "shortest_path"));
+    ScopedTimer timer(latency);
+
     if (!startZone || !targetZone) return {};
     
+    // Drop nodes left behind when the previous search stopped at its target
+    priorityQueue->clear();
+    
     // Create distance map and previous zone map
     std::unordered_map<std::string, int> distances;
     std::unordered_map<std::string, std::string> previous;
@@ -158,10 +176,12 @@ std::vector<std::string> PathFinder::findShortestPath(
         }
         
         visited[currentId] = true;
+        bool unreachable = current->distance == std::numeric_limits<int>::max();
         delete current;
         
-        // If we reached target zone, reconstruct path
-        if (currentId == targetZone->getZoneId()) {
+        // If we reached target zone, reconstruct path; the rest of the
+        // queue cannot be reached from the start
+        if (currentId == targetZone->getZoneId() || unreachable) {
             break;
         }
         
@@ -264,6 +284,11 @@ std::string PathFinder::findNearestAvailableZone(
     int zoneCount,
     std::vector<std::string>& path
 ) {
+    static MetricHistogram& latency = metrics().histogram(
+        "nexuspark_pathfinder_duration_seconds", "Time spent in PathFinder queries",
+        MetricsRegistry::label("query", "nearest_available"));
+    ScopedTimer timer(latency);
+
     // Find start zone
     Zone* startZone = nullptr;
     for (int i = 0; i < zoneCount; i++) {
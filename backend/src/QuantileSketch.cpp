@@ -0,0 +1,132 @@
+#include "../include/QuantileSketch.h"
+#include <cmath>
+
+const double QuantileSketch::RELATIVE_ACCURACY = 0.01;
+const double QuantileSketch::MIN_TRACKED_VALUE = 0.01;
+
+namespace {
+    // Bucket i covers (MIN * gamma^(i-1), MIN * gamma^i]
+    const double GAMMA = (1.0 + QuantileSketch::RELATIVE_ACCURACY) /
+                         (1.0 - QuantileSketch::RELATIVE_ACCURACY);
+    const double LOG_GAMMA = std::log(GAMMA);
+}
+
+// QuantileSketch constructor
+QuantileSketch::QuantileSketch() {
+    clear();
+}
+
+// Reset all buckets
+void QuantileSketch::clear() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = 0;
+    }
+    zeroCount = 0;
+    totalCount = 0;
+    sum = 0.0;
+    minValue = 0.0;
+    maxValue = 0.0;
+}
+
+// Map a value to its bucket (values beyond the range clamp to the last bucket)
+int QuantileSketch::bucketIndex(double value) {
+    int index = static_cast<int>(std::ceil(std::log(value / MIN_TRACKED_VALUE) / LOG_GAMMA));
+    if (index < 0) return 0;
+    if (index >= BUCKET_COUNT) return BUCKET_COUNT - 1;
+    return index;
+}
+
+// Representative value of a bucket (midpoint in relative terms)
+double QuantileSketch::bucketValue(int index) {
+    return MIN_TRACKED_VALUE * 2.0 * std::pow(GAMMA, index) / (GAMMA + 1.0);
+}
+
+// Add a sample
+void QuantileSketch::add(double value) {
+    if (value < 0.0 || std::isnan(value)) return;
+    
+    if (totalCount == 0) {
+        minValue = value;
+        maxValue = value;
+    } else {
+        if (value < minValue) minValue = value;
+        if (value > maxValue) maxValue = value;
+    }
+    
+    if (value < MIN_TRACKED_VALUE) {
+        zeroCount++;
+    } else {
+        counts[bucketIndex(value)]++;
+    }
+    totalCount++;
+    sum += value;
+}
+
+// Merge another sketch into this one
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.totalCount == 0) return;
+    
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] += other.counts[i];
+    }
+    
+    if (totalCount == 0) {
+        minValue = other.minValue;
+        maxValue = other.maxValue;
+    } else {
+        if (other.minValue < minValue) minValue = other.minValue;
+        if (other.maxValue > maxValue) maxValue = other.maxValue;
+    }
+    zeroCount += other.zeroCount;
+    totalCount += other.totalCount;
+    sum += other.sum;
+}
+
+// Estimate the q-th quantile
+double QuantileSketch::quantile(double q) const {
+    if (totalCount == 0) return 0.0;
+    if (q <= 0.0) return minValue;
+    if (q >= 1.0) return maxValue;
+    
+    uint64_t rank = static_cast<uint64_t>(q * (totalCount - 1));
+    if (rank < zeroCount) return minValue;
+    
+    uint64_t seen = zeroCount;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts[i];
+        if (seen > rank) {
+            double estimate = bucketValue(i);
+            // Never report outside the observed range
+            if (estimate < minValue) return minValue;
+            if (estimate > maxValue) return maxValue;
+            return estimate;
+        }
+    }
+    return maxValue;
+}
+
+// Get number of samples
+uint64_t QuantileSketch::getCount() const {
+    return totalCount;
+}
+
+// Get sum of samples
+double QuantileSketch::getSum() const {
+    return sum;
+}
+
+// Get mean of samples
+double QuantileSketch::getMean() const {
+    if (totalCount == 0) return 0.0;
+    return sum / totalCount;
+}
+
+// Get smallest sample
+double QuantileSketch::getMin() const {
+    return minValue;
+}
+
+// Get largest sample
+double QuantileSketch::getMax() const {
+    return maxValue;
+}
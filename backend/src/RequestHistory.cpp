@@ -0,0 +1,380 @@
+#include "../include/RequestHistory.h"
+#include <cstring>
+#include <thread>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define NEXUSPARK_AVX2_KERNELS 1
+#include <immintrin.h>
+#else
+#define NEXUSPARK_AVX2_KERNELS 0
+#endif
+
+namespace {
+    // ---------- Scalar kernels ----------
+    
+    long long countStateScalar(const uint8_t* states, size_t n, uint8_t state) {
+        long long count = 0;
+        for (size_t i = 0; i < n; i++) {
+            count += (states[i] == state);
+        }
+        return count;
+    }
+    
+    double sumWhereScalar(const uint8_t* states, const double* values, size_t n, uint8_t state) {
+        double total = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            if (states[i] == state) total += values[i];
+        }
+        return total;
+    }
+    
+    long long countCrossZoneScalar(const uint8_t* states, const uint8_t* flags, size_t n) {
+        long long count = 0;
+        for (size_t i = 0; i < n; i++) {
+            count += (states[i] == RELEASED && flags[i] != 0);
+        }
+        return count;
+    }
+    
+    void revenueByZoneScalar(const uint8_t* states, const double* costs,
+                             const uint16_t* zones, size_t n, double* totals) {
+        for (size_t i = 0; i < n; i++) {
+            if (states[i] == RELEASED) totals[zones[i]] += costs[i];
+        }
+    }
+    
+#if NEXUSPARK_AVX2_KERNELS
+    // ---------- AVX2 kernels ----------
+    
+    __attribute__((target("avx2")))
+    double horizontalSum(__m256d v) {
+        __m128d low = _mm256_castpd256_pd128(v);
+        __m128d high = _mm256_extractf128_pd(v, 1);
+        low = _mm_add_pd(low, high);
+        __m128d swapped = _mm_unpackhi_pd(low, low);
+        return _mm_cvtsd_f64(_mm_add_sd(low, swapped));
+    }
+    
+    // Widen 4 state bytes to a 64-bit lane mask (all ones where state matches)
+    __attribute__((target("avx2")))
+    __m256d stateMask4(const uint8_t* states, __m256i target) {
+        int32_t packed;
+        std::memcpy(&packed, states, sizeof(packed));
+        __m256i widened = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(widened, target));
+    }
+    
+    __attribute__((target("avx2,popcnt")))
+    long long countStateAvx2(const uint8_t* states, size_t n, uint8_t state) {
+        const __m256i target = _mm256_set1_epi8(static_cast<char>(state));
+        long long count = 0;
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + i));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, target)));
+            count += __builtin_popcount(mask);
+        }
+        return count + countStateScalar(states + i, n - i, state);
+    }
+    
+    __attribute__((target("avx2")))
+    double sumWhereAvx2(const uint8_t* states, const double* values, size_t n, uint8_t state) {
+        const __m256i target = _mm256_set1_epi64x(state);
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            acc0 = _mm256_add_pd(acc0, _mm256_and_pd(stateMask4(states + i, target),
+                                                     _mm256_loadu_pd(values + i)));
+            acc1 = _mm256_add_pd(acc1, _mm256_and_pd(stateMask4(states + i + 4, target),
+                                                     _mm256_loadu_pd(values + i + 4)));
+        }
+        return horizontalSum(_mm256_add_pd(acc0, acc1)) +
+               sumWhereScalar(states + i, values + i, n - i, state);
+    }
+    
+    __attribute__((target("avx2,popcnt")))
+    long long countCrossZoneAvx2(const uint8_t* states, const uint8_t* flags, size_t n) {
+        const __m256i released = _mm256_set1_epi8(static_cast<char>(RELEASED));
+        const __m256i zero = _mm256_setzero_si256();
+        long long count = 0;
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + i));
+            __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + i));
+            __m256i hit = _mm256_andnot_si256(_mm256_cmpeq_epi8(f, zero),
+                                              _mm256_cmpeq_epi8(s, released));
+            count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(hit)));
+        }
+        return count + countCrossZoneScalar(states + i, flags + i, n - i);
+    }
+    
+    // Masked per-zone accumulation; only worth it for a handful of zones
+    const int AVX2_MAX_ZONES = 16;
+    
+    __attribute__((target("avx2")))
+    void revenueByZoneAvx2(const uint8_t* states, const double* costs,
+                           const uint16_t* zones, size_t n, double* totals, int zoneCount) {
+        const __m256i released = _mm256_set1_epi64x(RELEASED);
+        __m256d acc[AVX2_MAX_ZONES];
+        for (int z = 0; z < zoneCount; z++) acc[z] = _mm256_setzero_pd();
+        
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d cost = _mm256_and_pd(stateMask4(states + i, released),
+                                         _mm256_loadu_pd(costs + i));
+            int64_t packed;
+            std::memcpy(&packed, zones + i, sizeof(packed));
+            __m256i zone = _mm256_cvtepu16_epi64(_mm_cvtsi64_si128(packed));
+            for (int z = 0; z < zoneCount; z++) {
+                __m256d match = _mm256_castsi256_pd(_mm256_cmpeq_epi64(zone, _mm256_set1_epi64x(z)));
+                acc[z] = _mm256_add_pd(acc[z], _mm256_and_pd(match, cost));
+            }
+        }
+        for (int z = 0; z < zoneCount; z++) {
+            totals[z] += horizontalSum(acc[z]);
+        }
+        revenueByZoneScalar(states + i, costs + i, zones + i, n - i, totals);
+    }
+#endif
+}
+
+bool RequestHistory::avx2Enabled = RequestHistory::isAvx2Supported();
+
+// HistoryAggregates constructor
+HistoryAggregates::HistoryAggregates()
+    : crossZoneCompleted(0), revenue(0.0), duration(0.0) {
+    for (int i = 0; i < REQUEST_STATE_COUNT; i++) {
+        stateCounts[i] = 0;
+    }
+}
+
+// Merge another partial aggregate into this one
+void HistoryAggregates::merge(const HistoryAggregates& other) {
+    for (int i = 0; i < REQUEST_STATE_COUNT; i++) {
+        stateCounts[i] += other.stateCounts[i];
+    }
+    crossZoneCompleted += other.crossZoneCompleted;
+    revenue += other.revenue;
+    duration += other.duration;
+    
+    if (revenueByZone.size() < other.revenueByZone.size()) {
+        revenueByZone.resize(other.revenueByZone.size(), 0.0);
+    }
+    for (size_t z = 0; z < other.revenueByZone.size(); z++) {
+        revenueByZone[z] += other.revenueByZone[z];
+    }
+}
+
+// RequestHistory constructor
+RequestHistory::RequestHistory() {}
+
+// Get (or assign) the handle for a zone ID
+uint16_t RequestHistory::internZone(const std::string& zoneId) {
+    auto it = zoneHandleById.find(zoneId);
+    if (it != zoneHandleById.end()) return it->second;
+    
+    uint16_t handle = static_cast<uint16_t>(zoneNames.size());
+    zoneNames.push_back(zoneId);
+    zoneHandleById[zoneId] = handle;
+    return handle;
+}
+
+// Append a request as one row
+void RequestHistory::append(const ParkingRequest& request) {
+    states.push_back(static_cast<uint8_t>(request.getState()));
+    costs.push_back(request.getTotalCost());
+    durations.push_back(request.getDuration());
+    zoneHandles.push_back(internZone(request.getAllocatedZone()));
+    crossZoneFlags.push_back(request.getIsCrossZone() ? 1 : 0);
+    requestTimes.push_back(static_cast<int64_t>(request.getRequestTime()));
+    allocationTimes.push_back(static_cast<int64_t>(request.getAllocationTime()));
+    completionTimes.push_back(static_cast<int64_t>(request.getCompletionTime()));
+}
+
+// Reserve room for rows
+void RequestHistory::reserve(size_t count) {
+    states.reserve(count);
+    costs.reserve(count);
+    durations.reserve(count);
+    zoneHandles.reserve(count);
+    crossZoneFlags.reserve(count);
+    requestTimes.reserve(count);
+    allocationTimes.reserve(count);
+    completionTimes.reserve(count);
+}
+
+// Drop all rows (zone handles stay valid)
+void RequestHistory::clear() {
+    states.clear();
+    costs.clear();
+    durations.clear();
+    zoneHandles.clear();
+    crossZoneFlags.clear();
+    requestTimes.clear();
+    allocationTimes.clear();
+    completionTimes.clear();
+}
+
+// Get number of rows
+size_t RequestHistory::size() const {
+    return states.size();
+}
+
+// Get number of interned zones
+int RequestHistory::getZoneCount() const {
+    return static_cast<int>(zoneNames.size());
+}
+
+// Get zone ID for a handle
+std::string RequestHistory::getZoneId(uint16_t handle) const {
+    return handle < zoneNames.size() ? zoneNames[handle] : "";
+}
+
+// Get handle for a zone ID
+int RequestHistory::findZoneHandle(const std::string& zoneId) const {
+    auto it = zoneHandleById.find(zoneId);
+    return it == zoneHandleById.end() ? -1 : it->second;
+}
+
+// Column accessors
+const uint8_t* RequestHistory::getStates() const { return states.data(); }
+const double* RequestHistory::getCosts() const { return costs.data(); }
+const double* RequestHistory::getDurations() const { return durations.data(); }
+const uint16_t* RequestHistory::getZoneHandles() const { return zoneHandles.data(); }
+const uint8_t* RequestHistory::getCrossZoneFlags() const { return crossZoneFlags.data(); }
+const int64_t* RequestHistory::getRequestTimes() const { return requestTimes.data(); }
+const int64_t* RequestHistory::getAllocationTimes() const { return allocationTimes.data(); }
+const int64_t* RequestHistory::getCompletionTimes() const { return completionTimes.data(); }
+
+// Count rows in a state
+long long RequestHistory::countState(RequestState state, size_t begin, size_t end) const {
+    if (end > size()) end = size();
+    if (begin >= end) return 0;
+#if NEXUSPARK_AVX2_KERNELS
+    if (avx2Enabled) return countStateAvx2(states.data() + begin, end - begin, state);
+#endif
+    return countStateScalar(states.data() + begin, end - begin, state);
+}
+
+// Sum cost of rows in a state
+double RequestHistory::sumCost(RequestState state, size_t begin, size_t end) const {
+    if (end > size()) end = size();
+    if (begin >= end) return 0.0;
+#if NEXUSPARK_AVX2_KERNELS
+    if (avx2Enabled) return sumWhereAvx2(states.data() + begin, costs.data() + begin, end - begin, state);
+#endif
+    return sumWhereScalar(states.data() + begin, costs.data() + begin, end - begin, state);
+}
+
+// Sum duration of rows in a state
+double RequestHistory::sumDuration(RequestState state, size_t begin, size_t end) const {
+    if (end > size()) end = size();
+    if (begin >= end) return 0.0;
+#if NEXUSPARK_AVX2_KERNELS
+    if (avx2Enabled) return sumWhereAvx2(states.data() + begin, durations.data() + begin, end - begin, state);
+#endif
+    return sumWhereScalar(states.data() + begin, durations.data() + begin, end - begin, state);
+}
+
+// Count released cross-zone rows
+long long RequestHistory::countCrossZoneCompleted(size_t begin, size_t end) const {
+    if (end > size()) end = size();
+    if (begin >= end) return 0;
+#if NEXUSPARK_AVX2_KERNELS
+    if (avx2Enabled) return countCrossZoneAvx2(states.data() + begin, crossZoneFlags.data() + begin, end - begin);
+#endif
+    return countCrossZoneScalar(states.data() + begin, crossZoneFlags.data() + begin, end - begin);
+}
+
+// Add released revenue per zone handle into totals (resized to the zone count)
+void RequestHistory::addRevenueByZone(std::vector<double>& totals, size_t begin, size_t end) const {
+    if (totals.size() < zoneNames.size()) totals.resize(zoneNames.size(), 0.0);
+    if (end > size()) end = size();
+    if (begin >= end) return;
+    
+    const uint8_t* s = states.data() + begin;
+    const double* c = costs.data() + begin;
+    const uint16_t* z = zoneHandles.data() + begin;
+#if NEXUSPARK_AVX2_KERNELS
+    if (avx2Enabled && getZoneCount() <= AVX2_MAX_ZONES) {
+        revenueByZoneAvx2(s, c, z, end - begin, totals.data(), getZoneCount());
+        return;
+    }
+#endif
+    revenueByZoneScalar(s, c, z, end - begin, totals.data());
+}
+
+// Compute all aggregates over a row range
+HistoryAggregates RequestHistory::aggregate(size_t begin, size_t end) const {
+    HistoryAggregates result;
+    for (int s = 0; s < REQUEST_STATE_COUNT; s++) {
+        result.stateCounts[s] = countState(static_cast<RequestState>(s), begin, end);
+    }
+    result.crossZoneCompleted = countCrossZoneCompleted(begin, end);
+    result.revenue = sumCost(RELEASED, begin, end);
+    result.duration = sumDuration(RELEASED, begin, end);
+    addRevenueByZone(result.revenueByZone, begin, end);
+    return result;
+}
+
+// Compute all aggregates over the whole history
+HistoryAggregates RequestHistory::aggregate() const {
+    return aggregate(0, size());
+}
+
+// Compute all aggregates using several worker threads
+HistoryAggregates RequestHistory::aggregateParallel(int threadCount) const {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) threadCount = 1;
+    }
+    
+    // Small inputs are not worth the thread start-up cost
+    const size_t minRowsPerThread = 65536;
+    size_t rows = size();
+    size_t maxThreads = rows / minRowsPerThread;
+    if (static_cast<size_t>(threadCount) > maxThreads) {
+        threadCount = maxThreads > 0 ? static_cast<int>(maxThreads) : 1;
+    }
+    if (threadCount == 1) return aggregate();
+    
+    // Each worker owns one contiguous range and one partial result
+    std::vector<HistoryAggregates> partials(threadCount);
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    size_t chunk = (rows + threadCount - 1) / threadCount;
+    for (int t = 0; t < threadCount; t++) {
+        size_t begin = t * chunk;
+        size_t end = begin + chunk < rows ? begin + chunk : rows;
+        workers.emplace_back([this, &partials, t, begin, end]() {
+            partials[t] = aggregate(begin, end);
+        });
+    }
+    
+    HistoryAggregates result;
+    for (int t = 0; t < threadCount; t++) {
+        workers[t].join();
+        result.merge(partials[t]);
+    }
+    return result;
+}
+
+// Check whether this CPU can run the AVX2 kernels
+bool RequestHistory::isAvx2Supported() {
+#if NEXUSPARK_AVX2_KERNELS
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Enable or disable the AVX2 kernels (ignored if unsupported)
+void RequestHistory::setAvx2Enabled(bool enabled) {
+    avx2Enabled = enabled && isAvx2Supported();
+}
+
+// Check whether the AVX2 kernels are in use
+bool RequestHistory::isAvx2Enabled() {
+    return avx2Enabled;
+}
@@ -0,0 +1,314 @@
+#include "../include/RequestParser.h"
+
+// ParkingRequestBody constructor
+ParkingRequestBody::ParkingRequestBody() : durationHours(0) {}
+
+// BatchOperation constructor
+BatchOperation::BatchOperation() : type(BATCH_INVALID), durationHours(0) {}
+
+// Minimal cursor over a JSON text
+struct JsonCursor {
+    const char* pos;
+    const char* end;
+
+    JsonCursor(std::string_view text) : pos(text.data()), end(text.data() + text.size()) {}
+
+    // Skip JSON whitespace
+    void skipSpace() {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) pos++;
+    }
+
+    // Consume an expected character after optional whitespace
+    bool consume(char c) {
+        skipSpace();
+        if (pos < end && *pos == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    // Read a string; raw is the text between the quotes, escapes left as-is
+    bool readString(std::string_view& raw, bool& hasEscape) {
+        if (!consume('"')) return false;
+        const char* start = pos;
+        hasEscape = false;
+        while (pos < end && *pos != '"') {
+            if (*pos == '\\') {
+                hasEscape = true;
+                pos++;
+                if (pos >= end) return false;
+            } else if (static_cast<unsigned char>(*pos) < 0x20) {
+                return false;
+            }
+            pos++;
+        }
+        if (pos >= end) return false;
+        raw = std::string_view(start, static_cast<size_t>(pos - start));
+        pos++;
+        return true;
+    }
+
+    // Read an optionally negative integer literal
+    bool readInteger(long long& value) {
+        skipSpace();
+        bool negative = pos < end && *pos == '-';
+        if (negative) pos++;
+        if (pos >= end || *pos < '0' || *pos > '9') return false;
+        value = 0;
+        while (pos < end && *pos >= '0' && *pos <= '9') {
+            if (value > 1000000000LL) return false;
+            value = value * 10 + (*pos - '0');
+            pos++;
+        }
+        // Reject fractions and exponents
+        if (pos < end && (*pos == '.' || *pos == 'e' || *pos == 'E')) return false;
+        if (negative) value = -value;
+        return true;
+    }
+
+    // Skip any JSON value (used for unknown keys)
+    bool skipValue() {
+        skipSpace();
+        if (pos >= end) return false;
+        if (*pos == '"') {
+            std::string_view ignored;
+            bool escaped;
+            return readString(ignored, escaped);
+        }
+        if (*pos == '{' || *pos == '[') {
+            int depth = 0;
+            while (pos < end) {
+                if (*pos == '"') {
+                    std::string_view ignored;
+                    bool escaped;
+                    if (!readString(ignored, escaped)) return false;
+                    continue;
+                }
+                if (*pos == '{' || *pos == '[') depth++;
+                if (*pos == '}' || *pos == ']') depth--;
+                pos++;
+                if (depth == 0) return true;
+            }
+            return false;
+        }
+        // Number or literal: run until a delimiter
+        const char* start = pos;
+        while (pos < end && *pos != ',' && *pos != '}' && *pos != ']' &&
+               *pos != ' ' && *pos != '\t' && *pos != '\n' && *pos != '\r') {
+            pos++;
+        }
+        return pos > start;
+    }
+};
+
+// Check an id against the allowed character set and length
+bool isValidId(std::string_view id) {
+    if (id.empty() || id.size() > static_cast<size_t>(MAX_ID_LENGTH)) return false;
+    for (char c : id) {
+        bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                  (c >= '0' && c <= '9') || c == '_' || c == '-';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// Parse the fixed request-parking schema in place
+bool parseParkingRequestBody(std::string_view body, ParkingRequestBody& out,
+                             std::string_view& error) {
+    JsonCursor cursor(body);
+    bool haveVehicle = false, haveZone = false, haveDuration = false;
+    out = ParkingRequestBody();
+    
+    if (!cursor.consume('{')) {
+        error = "Body must be a JSON object";
+        return false;
+    }
+    
+    if (!cursor.consume('}')) {
+        do {
+            std::string_view key;
+            bool keyEscaped;
+            if (!cursor.readString(key, keyEscaped) || !cursor.consume(':')) {
+                error = "Malformed JSON";
+                return false;
+            }
+            
+            if (key == "vehicleId" || key == "preferredZone") {
+                std::string_view value;
+                bool escaped;
+                if (!cursor.readString(value, escaped) || escaped || !isValidId(value)) {
+                    error = key == "vehicleId" ? "Invalid vehicleId" : "Invalid preferredZone";
+                    return false;
+                }
+                if (key == "vehicleId") {
+                    out.vehicleId = value;
+                    haveVehicle = true;
+                } else {
+                    out.preferredZone = value;
+                    haveZone = true;
+                }
+            } else if (key == "durationHours") {
+                long long hours;
+                if (!cursor.readInteger(hours) || hours < 1 || hours > MAX_DURATION_HOURS) {
+                    error = "durationHours must be an integer from 1 to 24";
+                    return false;
+                }
+                out.durationHours = static_cast<int>(hours);
+                haveDuration = true;
+            } else if (!cursor.skipValue()) {
+                error = "Malformed JSON";
+                return false;
+            }
+        } while (cursor.consume(','));
+        
+        if (!cursor.consume('}')) {
+            error = "Malformed JSON";
+            return false;
+        }
+    }
+    
+    cursor.skipSpace();
+    if (cursor.pos != cursor.end) {
+        error = "Trailing data after JSON object";
+        return false;
+    }
+    if (!haveVehicle || !haveZone || !haveDuration) {
+        error = "vehicleId, preferredZone and durationHours are required";
+        return false;
+    }
+    return true;
+}
+
+// Read a string-valued field; a non-string value is skipped and reported
+// through valid so the item can be rejected on its own
+static bool readIdField(JsonCursor& cursor, std::string_view& value, bool& valid) {
+    bool escaped;
+    cursor.skipSpace();
+    if (cursor.pos < cursor.end && *cursor.pos == '"') {
+        if (!cursor.readString(value, escaped)) return false;
+        valid = !escaped;
+        return true;
+    }
+    valid = false;
+    return cursor.skipValue();
+}
+
+// Parse one batch item; returns false only on malformed JSON
+static bool parseBatchItem(JsonCursor& cursor, BatchOperation& op) {
+    op = BatchOperation();
+    bool opValid = false, vehicleValid = false, zoneValid = false, requestValid = false;
+    bool haveDuration = false;
+    long long hours = 0;
+    
+    if (!cursor.consume('{')) return false;
+    if (!cursor.consume('}')) {
+        do {
+            std::string_view key;
+            bool keyEscaped;
+            if (!cursor.readString(key, keyEscaped) || !cursor.consume(':')) return false;
+            
+            bool ok = true;
+            if (key == "op") {
+                ok = readIdField(cursor, op.opName, opValid);
+            } else if (key == "vehicleId") {
+                ok = readIdField(cursor, op.vehicleId, vehicleValid);
+            } else if (key == "preferredZone") {
+                ok = readIdField(cursor, op.preferredZone, zoneValid);
+            } else if (key == "requestId") {
+                ok = readIdField(cursor, op.requestId, requestValid);
+            } else if (key == "durationHours") {
+                haveDuration = cursor.readInteger(hours);
+                if (!haveDuration) ok = cursor.skipValue();
+            } else {
+                ok = cursor.skipValue();
+            }
+            if (!ok) return false;
+        } while (cursor.consume(','));
+        if (!cursor.consume('}')) return false;
+    }
+    
+    // Validate the fields the operation needs
+    if (!opValid) {
+        op.error = "op is required";
+    } else if (op.opName == "request") {
+        if (!vehicleValid || !isValidId(op.vehicleId)) {
+            op.error = "Invalid vehicleId";
+        } else if (!zoneValid || !isValidId(op.preferredZone)) {
+            op.error = "Invalid preferredZone";
+        } else if (!haveDuration || hours < 1 || hours > MAX_DURATION_HOURS) {
+            op.error = "durationHours must be an integer from 1 to 24";
+        } else {
+            op.type = BATCH_REQUEST;
+            op.durationHours = static_cast<int>(hours);
+        }
+    } else if (op.opName == "occupy" || op.opName == "release" || op.opName == "cancel") {
+        if (!requestValid || !isValidId(op.requestId)) {
+            op.error = "Invalid requestId";
+        } else {
+            op.type = op.opName == "occupy" ? BATCH_OCCUPY :
+                      op.opName == "release" ? BATCH_RELEASE : BATCH_CANCEL;
+        }
+    } else {
+        op.error = "Unknown op";
+    }
+    return true;
+}
+
+// Parse a batch of parking operations in place
+bool parseBatchBody(std::string_view body, std::vector<BatchOperation>& out,
+                    std::string_view& error) {
+    JsonCursor cursor(body);
+    out.clear();
+    
+    // Either a bare array or {"operations":[...]}
+    bool wrapped = false;
+    cursor.skipSpace();
+    if (cursor.pos < cursor.end && *cursor.pos == '{') {
+        cursor.pos++;
+        std::string_view key;
+        bool keyEscaped;
+        if (!cursor.readString(key, keyEscaped) || key != "operations" || !cursor.consume(':')) {
+            error = "Body must be an array or {\"operations\":[...]}";
+            return false;
+        }
+        wrapped = true;
+    }
+    if (!cursor.consume('[')) {
+        error = "operations must be an array";
+        return false;
+    }
+    
+    if (!cursor.consume(']')) {
+        do {
+            if (out.size() >= static_cast<size_t>(MAX_BATCH_OPERATIONS)) {
+                error = "Too many operations (limit 100)";
+                return false;
+            }
+            out.emplace_back();
+            if (!parseBatchItem(cursor, out.back())) {
+                error = "Malformed JSON";
+                return false;
+            }
+        } while (cursor.consume(','));
+        if (!cursor.consume(']')) {
+            error = "Malformed JSON";
+            return false;
+        }
+    }
+    
+    if (wrapped && !cursor.consume('}')) {
+        error = "Malformed JSON";
+        return false;
+    }
+    cursor.skipSpace();
+    if (cursor.pos != cursor.end) {
+        error = "Trailing data after JSON";
+        return false;
+    }
+    if (out.empty()) {
+        error = "No operations";
+        return false;
+    }
+    return true;
+}
@@ -1,4 +1,5 @@
 ﻿#include "../include/RollbackManager.h"
+#include "../include/Metrics.h"
 #include <iostream>
 
 // RollbackOperation constructor
@@ -8,6 +9,13 @@ RollbackOperation::RollbackOperation(RollbackOpType type, const std::string& req
     : operationType(type), requestId(reqId), zoneId(zone), slotId(slot), 
       previousState(state), next(nullptr) {}
 
+// Undo operations held by all rollback managers
+static MetricGauge& stackDepthGauge() {
+    static MetricGauge& gauge = metrics().gauge(
+        "nexuspark_rollback_stack_depth", "Operations held on undo stacks");
+    return gauge;
+}
+
 // RollbackManager constructor
 RollbackManager::RollbackManager(int maxSteps) 
     : undoStack(nullptr), maxUndoSteps(maxSteps), currentSteps(0) {}
@@ -21,9 +29,14 @@ RollbackManager::~RollbackManager() {
 void RollbackManager::pushOperation(RollbackOperation* op) {
     if (!op) return;
     
+    static MetricCounter& recorded = metrics().counter(
+        "nexuspark_rollback_recorded_total", "Operations pushed onto undo stacks");
+    recorded.increment();
+
     op->next = undoStack;
     undoStack = op;
     currentSteps++;
+    stackDepthGauge().add(1);
     
     // If we exceed max steps, remove oldest from bottom
     if (currentSteps > maxUndoSteps) {
@@ -42,6 +55,7 @@ RollbackOperation* RollbackManager::popOperation() {
     RollbackOperation* op = undoStack;
     undoStack = undoStack->next;
     currentSteps--;
+    stackDepthGauge().add(-1);
     
     op->next = nullptr; // Detach from list
     return op;
@@ -54,22 +68,33 @@ void RollbackManager::clearStack() {
         undoStack = undoStack->next;
         delete temp;
     }
+    stackDepthGauge().add(-currentSteps);
     currentSteps = 0;
 }
 
 // Undo last operation
 bool RollbackManager::undoLastOperation(ParkingRequest** requests, int requestCount, 
                                         Zone** zones, int zoneCount) {
+    static MetricHistogram& latency = metrics().histogram(
+        "nexuspark_rollback_duration_seconds", "Time spent undoing one operation");
+    static MetricCounter& undone = metrics().counter(
+        "nexuspark_rollback_undo_total", "Undo attempts by outcome", MetricsRegistry::label("result", "ok"));
+    static MetricCounter& failed = metrics().counter(
+        "nexuspark_rollback_undo_total", "Undo attempts by outcome", MetricsRegistry::label("result", "failed"));
+
     if (!canUndo()) {
         std::cout << "❌ No operations to undo!" << std::endl;
+        failed.increment();
         return false;
     }
     
+    ScopedTimer timer(latency);
     RollbackOperation* op = popOperation();
     if (!op) return false;
     
     bool success = executeUndo(op, requests, requestCount, zones, zoneCount);
     delete op;
+    (success ? undone : failed).increment();
     
     return success;
 }
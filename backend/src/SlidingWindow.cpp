@@ -0,0 +1,129 @@
+#include "../include/SlidingWindow.h"
+
+// WindowTotals constructor
+WindowTotals::WindowTotals()
+    : requests(0), allocations(0), completed(0), cancelled(0),
+      crossZoneCompleted(0), revenue(0.0), duration(0.0) {}
+
+// Add another set of totals
+void WindowTotals::add(const WindowTotals& other) {
+    requests += other.requests;
+    allocations += other.allocations;
+    completed += other.completed;
+    cancelled += other.cancelled;
+    crossZoneCompleted += other.crossZoneCompleted;
+    revenue += other.revenue;
+    duration += other.duration;
+}
+
+// Get completion rate (percent of requests)
+double WindowTotals::getCompletionRate() const {
+    if (requests == 0) return 0.0;
+    return (static_cast<double>(completed) / requests) * 100.0;
+}
+
+// Get cancellation rate (percent of requests)
+double WindowTotals::getCancellationRate() const {
+    if (requests == 0) return 0.0;
+    return (static_cast<double>(cancelled) / requests) * 100.0;
+}
+
+// Get cross-zone rate (percent of completed)
+double WindowTotals::getCrossZoneRate() const {
+    if (completed == 0) return 0.0;
+    return (static_cast<double>(crossZoneCompleted) / completed) * 100.0;
+}
+
+// Get average duration of completed requests
+double WindowTotals::getAverageDuration() const {
+    if (completed == 0) return 0.0;
+    return duration / completed;
+}
+
+// Get revenue per parked hour
+double WindowTotals::getAverageRevenuePerHour() const {
+    if (duration == 0.0) return 0.0;
+    return revenue / duration;
+}
+
+// SlidingWindow constructor
+SlidingWindow::SlidingWindow(int secondsPerBucket, int capacity)
+    : buckets(capacity > 0 ? capacity : 1),
+      bucketSeconds(secondsPerBucket > 0 ? secondsPerBucket : 1),
+      newestStart(-1) {
+    for (Bucket& bucket : buckets) {
+        bucket.start = -1;
+    }
+}
+
+// Get the bucket for a timestamp (nullptr if it has already left the window)
+WindowTotals* SlidingWindow::bucketFor(time_t timestamp) {
+    time_t bucketStart = timestamp - (timestamp % bucketSeconds);
+    if (newestStart >= 0 &&
+        bucketStart <= newestStart - static_cast<time_t>(buckets.size()) * bucketSeconds) {
+        return nullptr;
+    }
+    if (bucketStart > newestStart) newestStart = bucketStart;
+    
+    Bucket& bucket = buckets[(bucketStart / bucketSeconds) % buckets.size()];
+    if (bucket.start != bucketStart) {
+        bucket.start = bucketStart;
+        bucket.totals = WindowTotals();
+    }
+    return &bucket.totals;
+}
+
+// Record a new request
+void SlidingWindow::recordRequest(time_t timestamp) {
+    WindowTotals* totals = bucketFor(timestamp);
+    if (totals) totals->requests++;
+}
+
+// Record an allocation
+void SlidingWindow::recordAllocation(time_t timestamp) {
+    WindowTotals* totals = bucketFor(timestamp);
+    if (totals) totals->allocations++;
+}
+
+// Record a released request
+void SlidingWindow::recordCompletion(time_t timestamp, double revenue, double duration, bool crossZone) {
+    WindowTotals* totals = bucketFor(timestamp);
+    if (!totals) return;
+    
+    totals->completed++;
+    totals->revenue += revenue;
+    totals->duration += duration;
+    if (crossZone) totals->crossZoneCompleted++;
+}
+
+// Record a cancelled request
+void SlidingWindow::recordCancellation(time_t timestamp) {
+    WindowTotals* totals = bucketFor(timestamp);
+    if (totals) totals->cancelled++;
+}
+
+// Sum the buckets inside the window
+WindowTotals SlidingWindow::getTotals(time_t now, int windowSeconds) const {
+    WindowTotals result;
+    if (windowSeconds <= 0) return result;
+    
+    time_t last = now - (now % bucketSeconds);
+    time_t first = now - windowSeconds + 1;
+    first -= first % bucketSeconds;
+    
+    time_t oldest = last - static_cast<time_t>(buckets.size() - 1) * bucketSeconds;
+    if (first < oldest) first = oldest;
+    
+    for (time_t t = first; t <= last; t += bucketSeconds) {
+        const Bucket& bucket = buckets[(t / bucketSeconds) % buckets.size()];
+        if (bucket.start == t) {
+            result.add(bucket.totals);
+        }
+    }
+    return result;
+}
+
+// Get the longest window that can be answered
+int SlidingWindow::getMaxWindowSeconds() const {
+    return static_cast<int>(buckets.size()) * bucketSeconds;
+}
@@ -0,0 +1,340 @@
+#include "../include/StaticAssetCache.h"
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <poll.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#ifdef NEXUSPARK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef NEXUSPARK_HAVE_BROTLI
+#include <brotli/encode.h>
+#endif
+
+// Files below this size are not worth compressing
+static const size_t MIN_COMPRESS_BYTES = 256;
+
+// StaticAsset constructor
+StaticAsset::StaticAsset() : size(0), inMemory(false) {}
+
+// 64-bit FNV-1a hash of the content, for strong ETags
+static uint64_t hashContent(const std::string& data) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Read a whole file
+static bool readFile(const std::string& path, std::string& out) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    char buffer[64 * 1024];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        out.append(buffer, got);
+    }
+    fclose(file);
+    return true;
+}
+
+// Gzip-compress data (empty result if unavailable or it fails)
+static std::string gzipCompress(const std::string& data) {
+    std::string out;
+#ifdef NEXUSPARK_HAVE_ZLIB
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    // windowBits 15 + 16 selects the gzip wrapper
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return out;
+    }
+    out.resize(deflateBound(&stream, data.size()));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = static_cast<uInt>(out.size());
+    int result = deflate(&stream, Z_FINISH);
+    out.resize(result == Z_STREAM_END ? stream.total_out : 0);
+    deflateEnd(&stream);
+#else
+    (void)data;
+#endif
+    return out;
+}
+
+// Brotli-compress data (empty result if unavailable or it fails)
+static std::string brotliCompress(const std::string& data) {
+    std::string out;
+#ifdef NEXUSPARK_HAVE_BROTLI
+    size_t encodedSize = BrotliEncoderMaxCompressedSize(data.size());
+    if (encodedSize == 0) return out;
+    out.resize(encodedSize);
+    if (BrotliEncoderCompress(BROTLI_MAX_QUALITY, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT,
+                              data.size(), reinterpret_cast<const uint8_t*>(data.data()),
+                              &encodedSize, reinterpret_cast<uint8_t*>(&out[0]))) {
+        out.resize(encodedSize);
+    } else {
+        out.clear();
+    }
+#else
+    (void)data;
+#endif
+    return out;
+}
+
+// Check whether a comma-separated header lists a token (ignoring q-values)
+static bool acceptsToken(std::string_view header, std::string_view token) {
+    while (!header.empty()) {
+        size_t comma = header.find(',');
+        std::string_view item = header.substr(0, comma);
+        size_t semi = item.find(';');
+        std::string_view name = item.substr(0, semi);
+        while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+        while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+        if (name == token) {
+            // "br;q=0" explicitly refuses the encoding
+            std::string_view params = semi == std::string_view::npos ? std::string_view() : item.substr(semi);
+            return params.find("q=0") == std::string_view::npos || params.find("q=0.") != std::string_view::npos;
+        }
+        if (comma == std::string_view::npos) break;
+        header.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+// StaticAssetCache constructor
+StaticAssetCache::StaticAssetCache(const std::string& directory, size_t maxInMemoryBytes)
+    : rootDir(directory), maxCachedFileBytes(maxInMemoryBytes),
+      table(std::make_shared<AssetTable>()), generation(0), stopFd(-1) {}
+
+// StaticAssetCache destructor
+StaticAssetCache::~StaticAssetCache() {
+    stopWatching();
+}
+
+// Content type from the file extension
+std::string StaticAssetCache::contentTypeFor(const std::string& path) {
+    size_t dot = path.rfind('.');
+    std::string ext = dot == std::string::npos ? "" : path.substr(dot + 1);
+    if (ext == "html" || ext == "htm") return "text/html; charset=utf-8";
+    if (ext == "css") return "text/css; charset=utf-8";
+    if (ext == "js") return "application/javascript; charset=utf-8";
+    if (ext == "json") return "application/json";
+    if (ext == "svg") return "image/svg+xml";
+    if (ext == "txt") return "text/plain; charset=utf-8";
+    if (ext == "png") return "image/png";
+    if (ext == "jpg" || ext == "jpeg") return "image/jpeg";
+    if (ext == "ico") return "image/x-icon";
+    if (ext == "woff2") return "font/woff2";
+    return "application/octet-stream";
+}
+
+// Text-like types benefit from compression; images and fonts do not
+bool StaticAssetCache::isCompressible(const std::string& contentType) {
+    return contentType.compare(0, 5, "text/") == 0 ||
+           contentType.find("javascript") != std::string::npos ||
+           contentType.find("json") != std::string::npos ||
+           contentType.find("svg") != std::string::npos;
+}
+
+// Load one file into an asset entry
+std::shared_ptr<const StaticAsset> StaticAssetCache::loadFile(const std::string& filePath) const {
+    struct stat info;
+    if (stat(filePath.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) return nullptr;
+
+    std::shared_ptr<StaticAsset> asset = std::make_shared<StaticAsset>();
+    asset->filePath = filePath;
+    asset->contentType = contentTypeFor(filePath);
+    asset->size = static_cast<size_t>(info.st_size);
+
+    char etag[64];
+    if (asset->size > maxCachedFileBytes) {
+        // Validator from size and modification time; content is read per request
+        snprintf(etag, sizeof(etag), "\"%zx-%llx\"", asset->size,
+                 static_cast<unsigned long long>(info.st_mtime));
+        asset->etag = etag;
+        return asset;
+    }
+
+    std::string data;
+    if (!readFile(filePath, data)) return nullptr;
+    asset->size = data.size();
+    snprintf(etag, sizeof(etag), "\"%016llx\"", static_cast<unsigned long long>(hashContent(data)));
+    asset->etag = etag;
+    asset->inMemory = true;
+
+    if (data.size() >= MIN_COMPRESS_BYTES && isCompressible(asset->contentType)) {
+        std::string gz = gzipCompress(data);
+        if (!gz.empty() && gz.size() < data.size()) {
+            asset->gzip = std::make_shared<const std::string>(std::move(gz));
+        }
+        std::string br = brotliCompress(data);
+        if (!br.empty() && br.size() < data.size()) {
+            asset->brotli = std::make_shared<const std::string>(std::move(br));
+        }
+    }
+    asset->identity = std::make_shared<const std::string>(std::move(data));
+    return asset;
+}
+
+// Recursively load a directory
+void StaticAssetCache::loadDirectory(const std::string& dir, const std::string& urlPrefix,
+                                     AssetTable& into) const {
+    DIR* handle = opendir(dir.c_str());
+    if (!handle) return;
+    while (dirent* entry = readdir(handle)) {
+        std::string name = entry->d_name;
+        if (name.empty() || name[0] == '.') continue;  // also skips editor temp files
+
+        std::string path = dir + "/" + name;
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) continue;
+        if (S_ISDIR(info.st_mode)) {
+            loadDirectory(path, urlPrefix + name + "/", into);
+        } else if (std::shared_ptr<const StaticAsset> asset = loadFile(path)) {
+            into[urlPrefix + name] = asset;
+        }
+    }
+    closedir(handle);
+}
+
+// Build a fresh table and swap it in
+void StaticAssetCache::reload() {
+    std::shared_ptr<AssetTable> fresh = std::make_shared<AssetTable>();
+    loadDirectory(rootDir, "/", *fresh);
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        table = fresh;
+    }
+    generation.fetch_add(1);
+}
+
+// Look up an asset by URL path
+std::shared_ptr<const StaticAsset> StaticAssetCache::find(const std::string& urlPath) const {
+    std::shared_ptr<const AssetTable> current;
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        current = table;
+    }
+    auto it = current->find(urlPath);
+    return it == current->end() ? nullptr : it->second;
+}
+
+// Get number of loaded assets
+size_t StaticAssetCache::getAssetCount() const {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    return table->size();
+}
+
+// Get reload generation
+uint64_t StaticAssetCache::getGeneration() const {
+    return generation.load();
+}
+
+// Serve an asset with conditional GET and content negotiation
+bool StaticAssetCache::serve(const HttpRequest& request, HttpResponse& response) const {
+    std::string path(request.path);
+    if (path == "/") path = "/index.html";
+    std::shared_ptr<const StaticAsset> asset = find(path);
+    if (!asset) return false;
+
+    response.contentType = asset->contentType;
+    response.setHeader("ETag", asset->etag);
+    response.setHeader("Cache-Control", "no-cache");  // always revalidate; 304s are cheap
+
+    std::string_view ifNoneMatch = request.getHeader("If-None-Match");
+    if (!ifNoneMatch.empty() &&
+        (ifNoneMatch == "*" || ifNoneMatch.find(asset->etag) != std::string_view::npos)) {
+        response.status = 304;
+        return true;
+    }
+    response.status = 200;
+
+    if (!asset->inMemory) {
+        int fd = open(asset->filePath.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) {
+            if (fd >= 0) close(fd);
+            response.status = 404;
+            response.contentType = "text/plain";
+            response.body = "Not Found";
+            return true;
+        }
+        response.fileFd = fd;
+        response.fileLength = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    // Pick the smallest variant the client accepts
+    if (asset->gzip || asset->brotli) {
+        response.setHeader("Vary", "Accept-Encoding");
+    }
+    std::string_view accept = request.getHeader("Accept-Encoding");
+    if (asset->brotli && acceptsToken(accept, "br")) {
+        response.setHeader("Content-Encoding", "br");
+        response.sharedBody = asset->brotli;
+    } else if (asset->gzip && acceptsToken(accept, "gzip")) {
+        response.setHeader("Content-Encoding", "gzip");
+        response.sharedBody = asset->gzip;
+    } else {
+        response.sharedBody = asset->identity;
+    }
+    return true;
+}
+
+// Start the inotify watcher thread
+bool StaticAssetCache::startWatching() {
+    if (watcher.joinable()) return true;
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stopFd < 0) return false;
+    watcher = std::thread([this]() { watchLoop(); });
+    return true;
+}
+
+// Stop the watcher thread
+void StaticAssetCache::stopWatching() {
+    if (!watcher.joinable()) return;
+    uint64_t one = 1;
+    (void)!write(stopFd, &one, sizeof(one));
+    watcher.join();
+    close(stopFd);
+    stopFd = -1;
+}
+
+// Reload after file changes, debounced so a burst of writes reloads once
+void StaticAssetCache::watchLoop() {
+    int notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notifyFd < 0) return;
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+    inotify_add_watch(notifyFd, rootDir.c_str(), mask);
+
+    char buffer[4096];
+    bool dirty = false;
+    while (true) {
+        pollfd fds[2];
+        fds[0].fd = notifyFd;
+        fds[0].events = POLLIN;
+        fds[1].fd = stopFd;
+        fds[1].events = POLLIN;
+        int ready = poll(fds, 2, dirty ? 100 : -1);
+        if (ready < 0) continue;
+        if (fds[1].revents & POLLIN) break;
+
+        if (ready == 0 && dirty) {
+            reload();
+            dirty = false;
+            continue;
+        }
+        if (fds[0].revents & POLLIN) {
+            while (read(notifyFd, buffer, sizeof(buffer)) > 0) {}
+            dirty = true;
+        }
+    }
+    close(notifyFd);
+}
@@ -0,0 +1,83 @@
+#include "../include/TopKTracker.h"
+#include <algorithm>
+
+// HeavyHitter constructor
+HeavyHitter::HeavyHitter(const std::string& k, long long c, long long e)
+    : key(k), count(c), error(e) {}
+
+// TopKTracker constructor
+TopKTracker::TopKTracker(int maxKeys) : capacity(maxKeys > 0 ? maxKeys : 1) {
+    entries.reserve(capacity);
+    slotByKey.reserve(capacity * 2);
+}
+
+// Find the counter with the smallest count
+int TopKTracker::findMinSlot() const {
+    int minSlot = 0;
+    for (size_t i = 1; i < entries.size(); i++) {
+        if (entries[i].count < entries[minSlot].count) {
+            minSlot = static_cast<int>(i);
+        }
+    }
+    return minSlot;
+}
+
+// Count an occurrence of key
+void TopKTracker::offer(const std::string& key, long long weight) {
+    auto it = slotByKey.find(key);
+    if (it != slotByKey.end()) {
+        entries[it->second].count += weight;
+        return;
+    }
+    
+    if (static_cast<int>(entries.size()) < capacity) {
+        slotByKey[key] = static_cast<int>(entries.size());
+        entries.push_back(HeavyHitter(key, weight, 0));
+        return;
+    }
+    
+    // Replace the smallest counter; its count becomes the new key's error bound
+    int slot = findMinSlot();
+    HeavyHitter& victim = entries[slot];
+    slotByKey.erase(victim.key);
+    victim.error = victim.count;
+    victim.count += weight;
+    victim.key = key;
+    slotByKey[key] = slot;
+}
+
+// Get the n keys with the highest counts (ties ordered by key)
+std::vector<HeavyHitter> TopKTracker::top(int n) const {
+    std::vector<HeavyHitter> result(entries);
+    size_t limit = std::min(result.size(), static_cast<size_t>(n > 0 ? n : 0));
+    
+    std::partial_sort(result.begin(), result.begin() + limit, result.end(),
+                      [](const HeavyHitter& a, const HeavyHitter& b) {
+                          if (a.count != b.count) return a.count > b.count;
+                          return a.key < b.key;
+                      });
+    result.resize(limit);
+    return result;
+}
+
+// Get the estimated count for a key (0 if not tracked)
+long long TopKTracker::estimate(const std::string& key) const {
+    auto it = slotByKey.find(key);
+    return it == slotByKey.end() ? 0 : entries[it->second].count;
+}
+
+// Get maximum number of tracked keys
+int TopKTracker::getCapacity() const {
+    return capacity;
+}
+
+// Get number of tracked keys
+int TopKTracker::getSize() const {
+    return static_cast<int>(entries.size());
+}
+
+// Forget all keys
+void TopKTracker::clear() {
+    entries.clear();
+    slotByKey.clear();
+}
@@ -1,6 +1,21 @@
 ﻿#include "../include/Vehicle.h"
 #include <sstream>
 
+// Vehicle type table generated from NEXUSPARK_VEHICLE_TYPES
+static const VehicleTypeInfo VEHICLE_TYPE_TABLE[VEHICLE_TYPE_COUNT] = {
+#define NEXUSPARK_VEHICLE_INFO(id, name, multiplier) {name, multiplier},
+    NEXUSPARK_VEHICLE_TYPES(NEXUSPARK_VEHICLE_INFO)
+#undef NEXUSPARK_VEHICLE_INFO
+};
+
+static const VehicleTypeInfo UNKNOWN_VEHICLE_TYPE = {"UNKNOWN", 1.0};
+
+// Look up the configuration for a vehicle type
+const VehicleTypeInfo& getVehicleTypeInfo(VehicleType type) {
+    if (type < 0 || type >= VEHICLE_TYPE_COUNT) return UNKNOWN_VEHICLE_TYPE;
+    return VEHICLE_TYPE_TABLE[type];
+}
+
 // Vehicle constructor
 Vehicle::Vehicle(const std::string& id, const std::string& zone, VehicleType vtype)
     : vehicleId(id), preferredZone(zone), type(vtype) {}
@@ -22,22 +37,12 @@ VehicleType Vehicle::getVehicleType() const {
 
 // Get vehicle type as string
 std::string Vehicle::getVehicleTypeString() const {
-    switch (type) {
-        case CAR: return "CAR";
-        case BIKE: return "BIKE";
-        case TRUCK: return "TRUCK";
-        default: return "UNKNOWN";
-    }
+    return getVehicleTypeInfo(type).name;
 }
 
 // Get type multiplier for pricing
 double Vehicle::getTypeMultiplier() const {
-    switch (type) {
-        case CAR: return 1.0;
-        case BIKE: return 0.5;
-        case TRUCK: return 2.0;
-        default: return 1.0;
-    }
+    return getVehicleTypeInfo(type).multiplier;
 }
 
 // Convert to string
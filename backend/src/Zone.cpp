@@ -1,7 +1,12 @@
 ﻿#include "../include/Zone.h"
 #include "../include/ParkingArea.h"
+#include "../include/JsonWriter.h"
 #include <iostream>
 #include <sstream>
+#include <atomic>
+
+// Process-wide zone change counter
+static std::atomic<uint64_t> zoneVersionCounter(0);
 
 // ZoneConnection constructor
 ZoneConnection::ZoneConnection(const std::string& zoneId, int dist, double penalty) 
@@ -10,7 +15,8 @@ ZoneConnection::ZoneConnection(const std::string& zoneId, int dist, double penal
 // Zone constructor
 Zone::Zone(const std::string& id, const std::string& name, int slots, double rate)
     : zoneId(id), zoneName(name), totalSlots(slots), availableSlots(slots), 
-      hourlyRate(rate), areaList(nullptr), areaCount(0), connections(nullptr) {}
+      hourlyRate(rate), areaList(nullptr), areaCount(0), connections(nullptr),
+      observer(nullptr), version(++zoneVersionCounter) {}
 
 // Zone destructor
 Zone::~Zone() {
@@ -94,6 +100,8 @@ ParkingSlot* Zone::findAvailableSlot() const {
 bool Zone::allocateSlot() {
     if (availableSlots > 0) {
         availableSlots--;
+        version = ++zoneVersionCounter;
+        if (observer) observer->onZoneChanged(*this);
         return true;
     }
     return false;
@@ -103,11 +111,33 @@ bool Zone::allocateSlot() {
 bool Zone::releaseSlot() {
     if (availableSlots < totalSlots) {
         availableSlots++;
+        version = ++zoneVersionCounter;
+        if (observer) observer->onZoneChanged(*this);
         return true;
     }
     return false;
 }
 
+// Set the observer notified on availability changes
+void Zone::setObserver(ZoneObserver* zoneObserver) {
+    observer = zoneObserver;
+}
+
+// Get the availability observer
+ZoneObserver* Zone::getObserver() const {
+    return observer;
+}
+
+// Get the version of the last availability change
+uint64_t Zone::getVersion() const {
+    return version;
+}
+
+// Get the latest version handed out to any zone
+uint64_t Zone::getCurrentVersion() {
+    return zoneVersionCounter.load();
+}
+
 // Get zone ID
 std::string Zone::getZoneId() const {
     return zoneId;
@@ -170,3 +200,22 @@ std::string Zone::getConnectionsString() const {
     
     return ss.str();
 }
+
+// Serialize as a JSON object
+void Zone::writeJson(JsonWriter& writer) const {
+    writer.beginObject()
+          .field("zoneId", zoneId)
+          .field("zoneName", zoneName)
+          .field("totalSlots", totalSlots)
+          .field("availableSlots", availableSlots)
+          .field("hourlyRate", hourlyRate)
+          .field("utilization", getUtilizationRate(), 1);
+    writer.key("connections").beginArray();
+    for (ZoneConnection* current = connections; current != nullptr; current = current->next) {
+        writer.beginObject()
+              .field("zoneId", current->connectedZoneId)
+              .field("distance", current->distance)
+              .endObject();
+    }
+    writer.endArray().endObject();
+}
@@ -0,0 +1,144 @@
+#include "../include/ZoneStatusBuffer.h"
+#include "../include/JsonWriter.h"
+#include <charconv>
+#include <cstring>
+
+// Width of the utilization field ("100.0")
+static const int UTILIZATION_WIDTH = 5;
+
+// Number of decimal digits in a non-negative value
+static int digitCount(int value) {
+    int digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        digits++;
+    }
+    return digits;
+}
+
+// Append a blank fixed-width field and return its position
+static PatchField reserveField(JsonWriter& writer, const std::string& json, int width) {
+    writer.raw(std::string(width, ' '));
+    PatchField field;
+    field.offset = json.size() - width;
+    field.width = width;
+    return field;
+}
+
+// ZoneStatusBuffer constructor
+ZoneStatusBuffer::ZoneStatusBuffer(Zone** zoneArray, int zoneCount) {
+    JsonWriter writer(json);
+    writer.beginArray();
+    
+    for (int i = 0; i < zoneCount; i++) {
+        Zone* zone = zoneArray[i];
+        writer.beginObject()
+              .field("zoneId", zone->getZoneId())
+              .field("zoneName", zone->getZoneName())
+              .field("totalSlots", zone->getTotalSlots());
+        
+        // Reserve room for any value from 0 to totalSlots
+        writer.key("availableSlots");
+        PatchField available = reserveField(writer, json, digitCount(zone->getTotalSlots()));
+        writer.field("hourlyRate", zone->getHourlyRate());
+        writer.key("utilization");
+        PatchField utilization = reserveField(writer, json, UTILIZATION_WIDTH);
+        
+        writer.key("connections").beginArray();
+        for (ZoneConnection* c = zone->getConnections(); c != nullptr; c = c->next) {
+            writer.beginObject()
+                  .field("zoneId", c->connectedZoneId)
+                  .field("distance", c->distance)
+                  .endObject();
+        }
+        writer.endArray().endObject();
+        
+        zones.push_back(zone);
+        availableFields.push_back(available);
+        utilizationFields.push_back(utilization);
+        zoneIndex[zone] = i;
+    }
+    writer.endArray();
+    changedFlags.assign(zoneCount, 0);
+    
+    for (int i = 0; i < zoneCount; i++) {
+        patch(i);
+        zoneArray[i]->setObserver(this);
+    }
+}
+
+// ZoneStatusBuffer destructor
+ZoneStatusBuffer::~ZoneStatusBuffer() {
+    for (const Zone* zone : zones) {
+        if (zone->getObserver() == this) {
+            const_cast<Zone*>(zone)->setObserver(nullptr);
+        }
+    }
+}
+
+// Right-align text in a field, padding with spaces
+void ZoneStatusBuffer::writeField(const PatchField& field, const char* text, int length) {
+    if (length > field.width) length = field.width;
+    char* dest = &json[field.offset];
+    std::memset(dest, ' ', field.width - length);
+    std::memcpy(dest + field.width - length, text, length);
+}
+
+// Rewrite one zone's availability and utilization
+void ZoneStatusBuffer::patch(int index) {
+    const Zone* zone = zones[index];
+    char text[32];
+    
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), zone->getAvailableSlots());
+    writeField(availableFields[index], text, static_cast<int>(result.ptr - text));
+    
+    result = std::to_chars(text, text + sizeof(text), zone->getUtilizationRate(),
+                           std::chars_format::fixed, 1);
+    writeField(utilizationFields[index], text, static_cast<int>(result.ptr - text));
+}
+
+// Patch the zone whose availability changed
+void ZoneStatusBuffer::onZoneChanged(const Zone& zone) {
+    auto it = zoneIndex.find(&zone);
+    if (it != zoneIndex.end()) {
+        patch(it->second);
+        if (!changedFlags[it->second]) {
+            changedFlags[it->second] = 1;
+            changedZones.push_back(it->second);
+        }
+    }
+}
+
+// Get the current zone list JSON
+const std::string& ZoneStatusBuffer::getJson() const {
+    return json;
+}
+
+// Write and clear the queued zone deltas
+int ZoneStatusBuffer::takeChanges(std::string& out) {
+    JsonWriter writer(out);
+    writer.beginArray();
+    for (int index : changedZones) {
+        writeDelta(writer, *zones[index]);
+        changedFlags[index] = 0;
+    }
+    writer.endArray();
+    
+    int count = static_cast<int>(changedZones.size());
+    changedZones.clear();
+    return count;
+}
+
+// Write one zone's availability delta
+void ZoneStatusBuffer::writeDelta(JsonWriter& writer, const Zone& zone) {
+    writer.beginObject()
+          .field("zoneId", zone.getZoneId())
+          .field("availableSlots", zone.getAvailableSlots())
+          .field("utilization", zone.getUtilizationRate(), 1)
+          .endObject();
+}
+
+// Get number of zones changed since the last drain
+int ZoneStatusBuffer::getPendingChangeCount() const {
+    return static_cast<int>(changedZones.size());
+}
@@ -0,0 +1,248 @@
+#include "include/HttpServer.h"
+#include "include/AdmissionControl.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+
+// Connect to the server on localhost
+static int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout;
+    timeout.tv_sec = 2;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read until `count` occurrences of marker arrive, the peer closes, or timeout
+static std::string readUntil(int fd, const std::string& marker, int count) {
+    std::string data;
+    char buffer[4096];
+    while (true) {
+        int seen = 0;
+        for (size_t pos = data.find(marker); pos != std::string::npos; pos = data.find(marker, pos + 1)) {
+            seen++;
+        }
+        if (seen >= count) break;
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        data.append(buffer, static_cast<size_t>(n));
+    }
+    return data;
+}
+
+// Read until `count` status lines arrive, scanning only new bytes
+static size_t countResponses(int fd, int count) {
+    const std::string marker = "HTTP/1.1 200";
+    std::string window;
+    char buffer[64 * 1024];
+    size_t seen = 0;
+    while (seen < static_cast<size_t>(count)) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        window.append(buffer, static_cast<size_t>(n));
+        for (size_t pos = window.find(marker); pos != std::string::npos; pos = window.find(marker, pos + 1)) {
+            seen++;
+        }
+        window.erase(0, window.size() > marker.size() ? window.size() - marker.size() + 1 : 0);
+    }
+    return seen;
+}
+
+int main() {
+    std::cout << "=== Testing Admission Control ===\n" << std::endl;
+
+    // Token bucket arithmetic
+    std::cout << "Test 1: Token bucket..." << std::endl;
+    TokenBucket bucket;
+    double retryAfter = 0.0;
+    bool first = bucket.take(2.0, 3.0, 100.0, retryAfter);
+    bucket.take(2.0, 3.0, 100.0, retryAfter);
+    bucket.take(2.0, 3.0, 100.0, retryAfter);
+    bool empty = !bucket.take(2.0, 3.0, 100.0, retryAfter);
+    double wait = retryAfter;
+    bool refilled = bucket.take(2.0, 3.0, 100.5, retryAfter);
+    if (!first || !empty || wait < 0.49 || wait > 0.51 || !refilled || bucket.isFull(2.0, 3.0, 100.5)) {
+        std::cout << "❌ Bucket arithmetic wrong (retry " << wait << ")" << std::endl;
+        return 1;
+    }
+    ClientRateLimiter limiter;
+    limiter.configure(1.0, 1.0);
+    bool clientA = limiter.allow(0x7F000001, 10.0, retryAfter) && !limiter.allow(0x7F000001, 10.0, retryAfter);
+    bool clientB = limiter.allow(0x0A000001, 10.0, retryAfter);
+    size_t tracked = limiter.getClientCount();
+    limiter.sweep(20.0);
+    LocalRateLimiter local;
+    local.configure(1.0, 1.0);
+    bool localA = local.allow(0x7F000001, 10.0, retryAfter) && !local.allow(0x7F000001, 10.0, retryAfter);
+    size_t localTracked = local.getClientCount();
+    local.sweep(20.0);
+    if (!clientA || !clientB || tracked != 2 || limiter.getClientCount() != 0 ||
+        !localA || localTracked != 1 || local.getClientCount() != 0) {
+        std::cout << "❌ Per-client limiter wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Burst of 3 then empty, retry after " << wait << "s; clients isolated" << std::endl;
+
+    // Per-client limit over loopback, with shared and per-worker buckets
+    std::cout << "\nTest 2: 429 with Retry-After..." << std::endl;
+    for (int perCore = 0; perCore < 2; perCore++) {
+        HttpServer limited(0, 2);
+        limited.setThreadPerCore(perCore == 1);
+        AdmissionConfig config;
+        config.clientRate = 1.0;
+        config.clientBurst = 2.0;
+        limited.setAdmission(config);
+        limited.route("GET", "/ping", [](const HttpRequest&, HttpResponse& res) {
+            res.contentType = "text/plain";
+            res.body = "pong";
+        });
+        limited.start();
+        std::thread limitedThread([&limited]() { limited.run(); });
+        int fd = connectTo(limited.getPort());
+        std::string four;
+        for (int i = 0; i < 4; i++) four += "GET /ping HTTP/1.1\r\nHost: t\r\n\r\n";
+        send(fd, four.data(), four.size(), 0);
+        std::string replies = readUntil(fd, "HTTP/1.1 ", 4);
+        close(fd);
+        limited.stop();
+        limitedThread.join();
+
+        AdmissionStats limitedStats = limited.getAdmissionStats();
+        int pongs = 0;
+        for (size_t pos = replies.find("pong"); pos != std::string::npos; pos = replies.find("pong", pos + 1)) pongs++;
+        if (pongs != 2 || replies.find("429 Too Many Requests") == std::string::npos ||
+            replies.find("Retry-After: 1") == std::string::npos || limitedStats.rateLimited != 2) {
+            std::cout << "❌ Rate limit not enforced" << (perCore ? " per core" : "") << ":\n" << replies << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "✅ 2 served, 2 answered 429 without running the handler, shared or per core" << std::endl;
+
+    // Overload: a slow handler builds a backlog behind it
+    std::cout << "\nTest 3: Bounded lanes, read priority, queue delay..." << std::endl;
+    HttpServer server(0, 1);
+    AdmissionConfig lanes;
+    lanes.maxQueued[PRIORITY_WRITE] = 3;
+    lanes.maxQueueDelayMs[PRIORITY_WRITE] = 20;
+    server.setAdmission(lanes);
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+    server.route("GET", "/slow", [&](const HttpRequest&, HttpResponse& res) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back("slow");
+        res.body = "{}";
+    });
+    server.route("GET", "/zones", [&](const HttpRequest&, HttpResponse& res) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back("read");
+        res.body = "{}";
+    });
+    server.route("POST", "/request-parking", [&](const HttpRequest&, HttpResponse& res) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back("write");
+        res.body = "{}";
+    });
+    server.start();
+    std::thread serverThread([&server]() { server.run(); });
+
+    int blocker = connectTo(server.getPort());
+    std::string slow = "GET /slow HTTP/1.1\r\nHost: t\r\n\r\n";
+    send(blocker, slow.data(), slow.size(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Four writes then one read arrive while the worker is busy
+    std::vector<int> writers;
+    std::string post = "POST /request-parking HTTP/1.1\r\nHost: t\r\nContent-Length: 2\r\n\r\n{}";
+    for (int i = 0; i < 4; i++) {
+        writers.push_back(connectTo(server.getPort()));
+        send(writers.back(), post.data(), post.size(), 0);
+    }
+    int reader = connectTo(server.getPort());
+    std::string get = "GET /zones HTTP/1.1\r\nHost: t\r\n\r\n";
+    send(reader, get.data(), get.size(), 0);
+
+    readUntil(blocker, "{}", 1);
+    std::string readReply = readUntil(reader, "\r\n\r\n", 1);
+    int ok = 0, unavailable = 0;
+    for (int writer : writers) {
+        std::string reply = readUntil(writer, "\r\n\r\n", 1);
+        if (reply.find("200 OK") != std::string::npos) ok++;
+        if (reply.find("503 Service Unavailable") != std::string::npos &&
+            reply.find("Retry-After: 1") != std::string::npos) unavailable++;
+        close(writer);
+    }
+    close(reader);
+    close(blocker);
+    server.stop();
+    serverThread.join();
+
+    AdmissionStats stats = server.getAdmissionStats();
+    std::cout << "Order:";
+    for (const std::string& step : order) std::cout << " " << step;
+    std::cout << "\nAdmitted " << stats.admitted[PRIORITY_READ] << " reads, " << stats.admitted[PRIORITY_WRITE]
+              << " writes; shed " << stats.shedQueueFull[PRIORITY_WRITE] << " full, "
+              << stats.shedQueueDelay[PRIORITY_WRITE] << " delayed" << std::endl;
+    if (readReply.find("200 OK") == std::string::npos || order.size() < 3 || order[1] != "read" ||
+        ok != 1 || unavailable != 3 || stats.shedQueueFull[PRIORITY_WRITE] != 1 ||
+        stats.shedQueueDelay[PRIORITY_WRITE] != 2 || stats.getShedTotal() != 3) {
+        std::cout << "❌ Overload handling wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Read served first, one write admitted, three shed with 503" << std::endl;
+
+    // A client that pipelines without reading is throttled, not buffered
+    std::cout << "\nTest 4: Backpressure on a client that stops reading..." << std::endl;
+    HttpServer bulk(0, 1);
+    std::atomic<int> served(0);
+    bulk.route("GET", "/blob", [&served](const HttpRequest&, HttpResponse& res) {
+        served++;
+        res.contentType = "application/octet-stream";
+        res.body.assign(64 * 1024, 'x');
+    });
+    bulk.start();
+    std::thread bulkThread([&bulk]() { bulk.run(); });
+    const int requestCount = 1000;
+    std::string burst;
+    for (int i = 0; i < requestCount; i++) burst += "GET /blob HTTP/1.1\r\nHost: t\r\n\r\n";
+    int bulkFd = connectTo(bulk.getPort());
+    send(bulkFd, burst.data(), burst.size(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    int servedWhileStalled = served.load();
+    size_t answered = countResponses(bulkFd, requestCount);
+    close(bulkFd);
+    bulk.stop();
+    bulkThread.join();
+
+    std::cout << "Handlers run while the client was not reading: " << servedWhileStalled
+              << " of " << requestCount << "; answered after it read: " << answered << std::endl;
+    if (servedWhileStalled >= requestCount / 2 || answered != static_cast<size_t>(requestCount)) {
+        std::cout << "❌ Output not bounded by the reader" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Pipeline held back while output was backed up, then served in full" << std::endl;
+
+    std::cout << "\n=== All Admission Control Tests Complete! ===" << std::endl;
+    return 0;
+}
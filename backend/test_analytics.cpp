@@ -123,8 +123,56 @@ int main() {
     std::string report = analytics.generateReport();
     std::cout << report << std::endl;
     
+    // Test incremental counters
+    std::cout << "\nTest 9: Incremental Counters..." << std::endl;
+    requests[6]->occupy();
+    requests[6]->release();
+    requests[8]->cancel();
+    ParkingRequest* lateRequest = new ParkingRequest("REQ011", "TRUCK002", "ZC", TRUCK);
+    analytics.trackRequest(lateRequest);
+    lateRequest->allocate("ZA", "A-103", 20.0, true);
+    
+    std::cout << "Completed requests: " << analytics.getCompletedRequests() << " (expected 5)" << std::endl;
+    std::cout << "Cancelled requests: " << analytics.getCancelledRequests() << " (expected 3)" << std::endl;
+    std::cout << "Total revenue: $" << analytics.getTotalRevenue() << " (expected 107.4)" << std::endl;
+    std::cout << "Peak usage zone: " << analytics.getPeakUsageZone() << std::endl;
+    if (!analytics.verifyCounters()) {
+        std::cout << "❌ Running counters disagree with full scan!" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Running counters match full scan" << std::endl;
+    std::cout << "Truck requests: " << analytics.getTypeCounters(TRUCK).totalRequests
+              << ", car revenue: $" << analytics.getTypeCounters(CAR).totalRevenue << std::endl;
+    
+    // Test versioned report cache
+    std::cout << "\nTest 10: Versioned Report Cache..." << std::endl;
+    uint64_t version = analytics.getStateVersion();
+    std::string json = analytics.generateReportJson();
+    std::cout << "State version: " << version << std::endl;
+    std::cout << "JSON: " << json << std::endl;
+    if (analytics.getStateVersion() != version || analytics.generateReportJson() != json) {
+        std::cout << "❌ Cached report changed without a state change" << std::endl;
+        return 1;
+    }
+    requests[7]->cancel();
+    if (analytics.getStateVersion() <= version || analytics.generateReportJson() == json) {
+        std::cout << "❌ Report not rebuilt after a state change" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Report rebuilt at version " << analytics.getStateVersion() << std::endl;
+    
+    // A background refresh leaves the next reader a cache hit
+    analytics.markChanged();
+    bool staleBefore = !analytics.isReportJsonCurrent();
+    analytics.refreshCachedReports();
+    if (!staleBefore || !analytics.isReportJsonCurrent()) {
+        std::cout << "❌ Refresh did not rebuild the stale report" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Stale report rebuilt ahead of the reader" << std::endl;
+    
     // Cleanup
-    std::cout << "\nTest 9: Cleanup..." << std::endl;
+    std::cout << "\nTest 11: Cleanup..." << std::endl;
     delete zoneA;
     delete zoneB;
     delete zoneC;
@@ -132,6 +180,7 @@ int main() {
     for (int i = 0; i < requestCount; i++) {
         delete requests[i];
     }
+    delete lateRequest;
     
     std::cout << "\n=== All Analytics Tests Complete! ===" << std::endl;
     return 0;
@@ -0,0 +1,124 @@
+#include "include/AnomalyDetector.h"
+#include "include/Analytics.h"
+#include "include/Zone.h"
+#include "include/ParkingSystem.h"
+#include <string>
+#include <iostream>
+#include <vector>
+
+int main() {
+    std::cout << "=== Testing Anomaly Detection ===\n" << std::endl;
+    
+    // Normal fluctuation must not alarm
+    std::cout << "Test 1: Stable occupancy..." << std::endl;
+    AnomalyDetector stable(2.0);
+    double score = 0.0;
+    int falseAlarms = 0;
+    for (int i = 0; i < 500; i++) {
+        double value = 60.0 + ((i * 7) % 5) - 2.0;  // 58..62
+        if (stable.update(value, score) != ANOMALY_NONE) falseAlarms++;
+    }
+    std::cout << "Mean: " << stable.getMean() << ", false alarms: " << falseAlarms << std::endl;
+    if (falseAlarms > 0) {
+        std::cout << "❌ Stable signal raised alarms" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ No alarms on normal fluctuation" << std::endl;
+    
+    // A sudden jump is a point anomaly
+    std::cout << "\nTest 2: Sudden drop (sensor failure)..." << std::endl;
+    AnomalyKind kind = stable.update(0.0, score);
+    std::cout << "Kind: " << kind << ", z-score: " << score << std::endl;
+    if (kind != ANOMALY_DROP) {
+        std::cout << "❌ Drop not detected" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Drop detected" << std::endl;
+    
+    // A small sustained shift is caught by CUSUM, not by the z-score test
+    std::cout << "\nTest 3: Sustained small shift..." << std::endl;
+    AnomalyDetector drifting(2.0);
+    for (int i = 0; i < 100; i++) drifting.update(50.0, score);
+    int detectedAt = -1;
+    AnomalyKind shiftKind = ANOMALY_NONE;
+    for (int i = 0; i < 50 && detectedAt < 0; i++) {
+        AnomalyKind k = drifting.update(53.0, score);  // +1.5 std devs
+        if (k != ANOMALY_NONE) {
+            detectedAt = i;
+            shiftKind = k;
+        }
+    }
+    std::cout << "Detected after " << detectedAt + 1 << " samples" << std::endl;
+    if (shiftKind != ANOMALY_SHIFT_UP) {
+        std::cout << "❌ Shift not detected" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Change point detected" << std::endl;
+    
+    // Analytics raises alerts per zone through the callback
+    std::cout << "\nTest 4: Zone alerts from Analytics..." << std::endl;
+    Zone* zoneA = new Zone("ZA", "Zone A", 100, 5.0);
+    Zone* zoneB = new Zone("ZB", "Zone B", 100, 5.0);
+    Zone* zones[] = {zoneA, zoneB};
+    Analytics analytics(nullptr, 0, zones, 2);
+    
+    std::vector<AnomalyAlert> received;
+    analytics.setAlertCallback([&received](const AnomalyAlert& alert) {
+        received.push_back(alert);
+    });
+    
+    for (int i = 0; i < 50; i++) zoneA->allocateSlot();
+    for (int i = 0; i < 40; i++) zoneB->allocateSlot();
+    time_t now = 1700000000;
+    for (int i = 0; i < 30; i++) {
+        analytics.sampleOccupancy(now);
+        now += 60;
+    }
+    for (int i = 0; i < 45; i++) zoneA->releaseSlot();  // 50% -> 5%
+    analytics.sampleOccupancy(now);
+    
+    std::cout << "Alerts received: " << received.size() << std::endl;
+    if (received.size() != 1 || received[0].zoneId != "ZA" ||
+        received[0].metric != "occupancy" || received[0].kind != ANOMALY_DROP) {
+        std::cout << "❌ Expected one occupancy drop in ZA" << std::endl;
+        return 1;
+    }
+    std::string json = analytics.getRecentAlertsJson(10);
+    std::cout << "JSON: " << json << std::endl;
+    if (json.find("\"kind\":\"DROP\"") == std::string::npos) {
+        std::cout << "❌ Alert missing from JSON" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Alert delivered through callback and JSON" << std::endl;
+    
+    delete zoneA;
+    delete zoneB;
+    
+    // Requests turned away by full zones still count as arrivals
+    std::cout << "\nTest 5: Surge of turned-away arrivals..." << std::endl;
+    ParkingSystem system;
+    system.initializeZones();
+    std::vector<AnomalyAlert> surges;
+    system.setAlertCallback([&surges](const AnomalyAlert& alert) {
+        if (alert.metric == "arrivals") surges.push_back(alert);
+    });
+    int parked = 0;
+    while (!system.requestParking("P" + std::to_string(parked), "ZA", 1).empty()) parked++;
+    for (int minute = 0; minute < 15; minute++) {
+        system.requestParking("R" + std::to_string(minute), "ZB", 1);
+        system.recordOccupancySample(now);
+        now += 60;
+    }
+    for (int i = 0; i < 20; i++) system.requestParking("S" + std::to_string(i), "ZB", 1);
+    system.recordOccupancySample(now);
+    
+    std::cout << "Parked " << parked << " before the lot filled; arrival alerts: " << surges.size() << std::endl;
+    if (surges.size() != 1 || surges[0].zoneId != "ZB" || surges[0].kind != ANOMALY_SPIKE) {
+        std::cout << "❌ Expected one arrival spike in ZB" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Spike raised for arrivals nobody could be parked for" << std::endl;
+    
+    std::cout << "\n=== All Anomaly Detection Tests Complete! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "include/HttpServer.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+
+using Clock = std::chrono::steady_clock;
+
+// Connect to the server on localhost
+static int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout;
+    timeout.tv_sec = 2;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read until `count` occurrences of marker arrive, the peer closes, or timeout
+static std::string readUntil(int fd, const std::string& marker, int count) {
+    std::string data;
+    char buffer[4096];
+    while (true) {
+        int seen = 0;
+        for (size_t pos = data.find(marker); pos != std::string::npos; pos = data.find(marker, pos + 1)) {
+            seen++;
+        }
+        if (seen >= count) break;
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        data.append(buffer, static_cast<size_t>(n));
+    }
+    return data;
+}
+
+// Milliseconds since start
+static long long elapsedMs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+// Coroutine used outside any server
+static HttpTask addLater(int a, int b, int& sum) {
+    sum = co_await offload([a, b]() { return a + b; });
+    co_await offload([]() { throw std::runtime_error("late failure"); });
+}
+
+int main() {
+    std::cout << "=== Testing Async Handlers ===\n" << std::endl;
+
+    // Task mechanics without a server: offload runs inline
+    std::cout << "Test 1: Task lifecycle..." << std::endl;
+    int sum = 0;
+    HttpTask task = addLater(2, 3, sum);
+    bool lazy = task && !task.done() && sum == 0;
+    task.getHandle().resume();
+    std::string caught;
+    try {
+        task.rethrow();
+    } catch (const std::exception& e) {
+        caught = e.what();
+    }
+    if (!lazy || !task.done() || sum != 5 || caught != "late failure") {
+        std::cout << "❌ Task lifecycle wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Starts suspended, result 5, exception kept for the server" << std::endl;
+
+    // One worker: a slow report must not hold up a short request
+    HttpServer server(0, 1);
+    server.setOffloadThreads(1);
+    server.routeAsync("GET", "/report", [](const HttpRequest& req, HttpResponse& res) -> HttpTask {
+        std::string name(req.getQueryParam("name"));
+        auto build = [name]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            return "report:" + name;
+        };
+        std::string report = co_await offload(build);
+        res.contentType = "text/plain";
+        res.body = report;
+    });
+    server.routeAsync("POST", "/flush", [](const HttpRequest& req, HttpResponse& res) -> HttpTask {
+        std::string body(req.body);
+        auto flush = [body]() {
+            if (body == "fail") throw std::runtime_error("disk full");
+        };
+        co_await offload(flush);
+        res.body = "{\"flushed\":true}";
+    });
+    server.route("GET", "/zones", [](const HttpRequest&, HttpResponse& res) {
+        res.body = "{\"zones\":[]}";
+    });
+    if (!server.start()) {
+        std::cout << "❌ Server failed to start" << std::endl;
+        return 1;
+    }
+    std::thread serverThread([&server]() { server.run(); });
+
+    std::cout << "\nTest 2: Short request during a slow report..." << std::endl;
+    Clock::time_point start = Clock::now();
+    int reportFd = connectTo(server.getPort());
+    std::string report = "GET /report?name=daily HTTP/1.1\r\nHost: t\r\n\r\n";
+    send(reportFd, report.data(), report.size(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    int suspendedDuring = server.getSuspendedCount();
+    int zonesFd = connectTo(server.getPort());
+    std::string zones = "GET /zones HTTP/1.1\r\nHost: t\r\n\r\n";
+    send(zonesFd, zones.data(), zones.size(), 0);
+    std::string zonesReply = readUntil(zonesFd, "]}", 1);
+    long long zonesMs = elapsedMs(start);
+    std::string reportReply = readUntil(reportFd, "report:daily", 1);
+    long long reportMs = elapsedMs(start);
+    close(zonesFd);
+    std::cout << "zones after " << zonesMs << "ms, report after " << reportMs << "ms" << std::endl;
+    if (suspendedDuring != 1 || zonesReply.find("200 OK") == std::string::npos || zonesMs >= 200 ||
+        reportReply.find("200 OK") == std::string::npos || reportMs < 300) {
+        std::cout << "❌ Short request stalled behind the report" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ /zones answered while the report was suspended" << std::endl;
+
+    // Pipelined follow-ups wait for the async response, in order
+    std::cout << "\nTest 3: Pipelining behind an async handler..." << std::endl;
+    std::string pipelined = "GET /report?name=a HTTP/1.1\r\nHost: t\r\n\r\n"
+                            "GET /zones HTTP/1.1\r\nHost: t\r\n\r\n"
+                            "GET /report?name=b HTTP/1.1\r\nHost: t\r\n\r\n";
+    send(reportFd, pipelined.data(), pipelined.size(), 0);
+    std::string replies = readUntil(reportFd, "HTTP/1.1 200", 3);
+    size_t first = replies.find("report:a");
+    size_t second = replies.find("{\"zones\":[]}");
+    size_t third = replies.find("report:b");
+    if (first == std::string::npos || second == std::string::npos || third == std::string::npos ||
+        !(first < second && second < third)) {
+        std::cout << "❌ Responses out of order:\n" << replies << std::endl;
+        return 1;
+    }
+    close(reportFd);
+    std::cout << "✅ Three responses in request order" << std::endl;
+
+    // Exceptions from offloaded work surface in the handler
+    std::cout << "\nTest 4: Failures and abandoned connections..." << std::endl;
+    int flushFd = connectTo(server.getPort());
+    std::string flushes = "POST /flush HTTP/1.1\r\nHost: t\r\nContent-Length: 4\r\n\r\nfail"
+                          "POST /flush HTTP/1.1\r\nHost: t\r\nContent-Length: 2\r\n\r\nok";
+    send(flushFd, flushes.data(), flushes.size(), 0);
+    std::string flushReplies = readUntil(flushFd, "{\"flushed\":true}", 1);
+    close(flushFd);
+
+    // A client that leaves mid-report must not take the worker down with it
+    int leaver = connectTo(server.getPort());
+    send(leaver, report.data(), report.size(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    close(leaver);
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    int after = connectTo(server.getPort());
+    send(after, zones.data(), zones.size(), 0);
+    std::string afterReply = readUntil(after, "]}", 1);
+    close(after);
+    int suspendedAfter = server.getSuspendedCount();
+
+    server.stop();
+    serverThread.join();
+    if (flushReplies.find("500 Internal Server Error") == std::string::npos ||
+        flushReplies.find("disk full") == std::string::npos ||
+        flushReplies.find("{\"flushed\":true}") == std::string::npos ||
+        afterReply.find("200 OK") == std::string::npos || suspendedAfter != 0) {
+        std::cout << "❌ Failure handling wrong:\n" << flushReplies << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Offload failure answered 500; abandoned report cleaned up" << std::endl;
+
+    std::cout << "\n=== All Async Handler Tests Complete! ===" << std::endl;
+    return 0;
+}
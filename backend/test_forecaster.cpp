@@ -0,0 +1,111 @@
+#include "include/OccupancyForecaster.h"
+#include "include/AllocationEngine.h"
+#include "include/ParkingSystem.h"
+#include <iostream>
+
+int main() {
+    std::cout << "=== Testing Occupancy Forecaster ===\n" << std::endl;
+    
+    time_t now = time(nullptr);
+    
+    // Rising occupancy: 20% -> 80% over one hour
+    std::cout << "Test 1: Learning a rising trend..." << std::endl;
+    OccupancyForecaster rising;
+    for (int minute = 60; minute >= 0; minute--) {
+        rising.update(now - minute * 60, 0.8 - minute * 0.01);
+    }
+    double current = rising.forecast(now, 0);
+    double ahead = rising.forecast(now, 15);
+    std::cout << "Now: " << current * 100 << "%, in 15 min: " << ahead * 100 << "%" << std::endl;
+    std::cout << "Free slots of 50 in 15 min: " << rising.forecastFreeSlots(50, now, 15) << std::endl;
+    if (!(ahead > current)) {
+        std::cout << "❌ Trend not picked up" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Forecast follows the trend" << std::endl;
+    
+    // Allocator avoids overflow zones forecast to fill
+    std::cout << "\nTest 2: Steering overflow allocations..." << std::endl;
+    Zone* zones[3];
+    zones[0] = new Zone("ZA", "Zone A", 1, 5.0);
+    zones[1] = new Zone("ZB", "Zone B", 10, 5.0);
+    zones[2] = new Zone("ZC", "Zone C", 10, 5.0);
+    zones[0]->addConnection(new ZoneConnection("ZB", 300));
+    zones[0]->addConnection(new ZoneConnection("ZC", 800));
+    zones[1]->addConnection(new ZoneConnection("ZA", 300));
+    zones[2]->addConnection(new ZoneConnection("ZA", 800));
+    zones[0]->allocateSlot();  // preferred zone is full
+    
+    OccupancyForecaster forecasters[3];
+    for (int minute = 20; minute >= 0; minute--) {
+        forecasters[0].update(now - minute * 60, 1.0);
+        forecasters[1].update(now - minute * 60, 0.5 + (20 - minute) * 0.025);  // filling fast
+        forecasters[2].update(now - minute * 60, 0.1);
+    }
+    
+    AllocationEngine allocator(zones, 3);
+    std::vector<std::string> path;
+    std::string withoutForecast = allocator.findNearestAvailableZone("ZA", path);
+    allocator.setForecasters(forecasters, 15);
+    path.clear();
+    std::string withForecast = allocator.findNearestAvailableZone("ZA", path);
+    std::cout << "Nearest zone without forecast: " << withoutForecast << std::endl;
+    std::cout << "Nearest zone with forecast: " << withForecast << std::endl;
+    if (withoutForecast != "ZB" || withForecast != "ZC") {
+        std::cout << "❌ Allocation was not steered" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Overflow steered away from filling zone" << std::endl;
+    
+    for (int i = 0; i < 3; i++) {
+        delete zones[i];
+    }
+    
+    // End to end: occupancy samples taken by the parking system steer its
+    // own overflow allocations. ZB (500m from ZA) has one slot left but has
+    // been full for ten minutes; ZC (800m) is empty.
+    std::cout << "\nTest 3: Steering through ParkingSystem..." << std::endl;
+    std::string overflowZone[2];
+    for (int sampled = 0; sampled < 2; sampled++) {
+        ParkingSystem system;
+        system.initializeZones();
+        std::string lastInB;
+        for (int i = 0; i < 15; i++) lastInB = system.requestParking("B" + std::to_string(i), "ZB", 1);
+        for (int i = 0; i < 20; i++) system.requestParking("A" + std::to_string(i), "ZA", 1);
+        if (sampled) {
+            for (int minute = 10; minute >= 0; minute--) system.recordOccupancySample(now - minute * 60);
+        }
+        system.occupyParking(lastInB);
+        system.releaseParking(lastInB);
+        const ParkingRequest* overflow = system.getRequest(system.requestParking("A-late", "ZA", 1));
+        overflowZone[sampled] = overflow ? overflow->getAllocatedZone() : "";
+    }
+    std::cout << "Overflow from ZA without samples: " << overflowZone[0]
+              << ", after ten minutes of samples: " << overflowZone[1] << std::endl;
+    if (overflowZone[0] != "ZB" || overflowZone[1] != "ZC") {
+        std::cout << "❌ Sampled forecasts did not steer the allocation" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Overflow skipped the zone forecast to stay full" << std::endl;
+
+    // Roads: ZA-ZB 500, ZA-ZC 800, ZB-ZC 300, ZB-ZD 700, ZC-ZE 400, ZD-ZE 600
+    std::cout << "\nTest 4: Overflow measured from the preferred zone..." << std::endl;
+    ParkingSystem roads;
+    roads.initializeZones();
+    for (int i = 0; i < 18; i++) roads.requestParking("D" + std::to_string(i), "ZD", 1);
+    const ParkingRequest* fromD = roads.getRequest(roads.requestParking("D-late", "ZD", 1));
+    for (int i = 0; i < 25; i++) roads.requestParking("C" + std::to_string(i), "ZC", 1);
+    for (int i = 0; i < 15; i++) roads.requestParking("B" + std::to_string(i), "ZB", 1);
+    const ParkingRequest* fromB = roads.getRequest(roads.requestParking("B-late", "ZB", 1));
+    std::string zoneFromD = fromD ? fromD->getAllocatedZone() : "";
+    std::string zoneFromB = fromB ? fromB->getAllocatedZone() : "";
+    std::cout << "Overflow from ZD: " << zoneFromD << ", from ZB with ZC full: " << zoneFromB << std::endl;
+    if (zoneFromD != "ZE" || zoneFromB != "ZA") {
+        std::cout << "❌ Overflow went to the zone nearest ZA, not the driver" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ ZD overflows to ZE (600) and ZB to ZA (500)" << std::endl;
+    
+    std::cout << "\n=== All Forecaster Tests Complete! ===" << std::endl;
+    return 0;
+}
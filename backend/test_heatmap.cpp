@@ -0,0 +1,108 @@
+#include "include/OccupancyHeatmap.h"
+#include "include/Analytics.h"
+#include "include/Zone.h"
+#include "include/ParkingSystem.h"
+#include <iostream>
+#include <cmath>
+#include <string>
+
+// Value a zone's heatmap JSON holds for one hour of the week ("" if absent)
+static std::string cellValue(const std::string& json, const std::string& zoneId, int hour) {
+    size_t pos = json.find("{\"zoneId\":\"" + zoneId + "\",\"average\":[");
+    if (pos == std::string::npos) return "";
+    pos = json.find('[', pos) + 1;
+    for (int i = 0; i < hour; i++) pos = json.find(',', pos) + 1;
+    return json.substr(pos, json.find_first_of(",]", pos) - pos);
+}
+
+int main() {
+    std::cout << "=== Testing Occupancy Heatmap ===\n" << std::endl;
+    
+    // Hour-of-week mapping
+    std::cout << "Test 1: Hour-of-week mapping..." << std::endl;
+    time_t monday = 1699833600;  // Monday 2023-11-13 00:00 UTC
+    int h0 = OccupancyHeatmap::hourOfWeek(monday);
+    int h1 = OccupancyHeatmap::hourOfWeek(monday + 3600 * 25 + 1800);  // Tuesday 01:30
+    int h2 = OccupancyHeatmap::hourOfWeek(monday + 7 * 24 * 3600);     // next Monday
+    std::cout << "Monday 00:00 -> " << h0 << ", Tuesday 01:30 -> " << h1
+              << ", next Monday -> " << h2 << std::endl;
+    if (h0 != 0 || h1 != 25 || h2 != 0) {
+        std::cout << "❌ Wrong hour-of-week" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Hours mapped correctly" << std::endl;
+    
+    // Running averages across weeks
+    std::cout << "\nTest 2: Averaging samples..." << std::endl;
+    OccupancyHeatmap map({"ZA", "ZB"});
+    map.addSample(0, monday + 600, 40.0);
+    map.addSample(0, monday + 1200, 60.0);
+    map.addSample(0, monday + 7 * 24 * 3600, 80.0);  // same cell, next week
+    map.addSample(1, monday + 3600 * 25, 10.0);
+    std::cout << "ZA Mon 00h: " << map.getAverage(0, 0) << " over " << map.getCount(0, 0)
+              << " samples, ZB Tue 01h: " << map.getAverage(1, 25) << std::endl;
+    if (std::fabs(map.getAverage(0, 0) - 60.0) > 1e-9 || map.getCount(0, 0) != 3 ||
+        std::fabs(map.getAverage(1, 25) - 10.0) > 1e-9 || map.getAverage(1, 0) >= 0.0) {
+        std::cout << "❌ Wrong cell averages" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Cell averages correct" << std::endl;
+    
+    // Serialization
+    std::cout << "\nTest 3: JSON and binary payloads..." << std::endl;
+    std::string json = map.toJson();
+    std::string binary = map.toBinary();
+    std::cout << "JSON: " << json.size() << " bytes, binary: " << binary.size() << " bytes" << std::endl;
+    size_t expectedBinary = 10 + (1 + 2) * 2 + 2 * 168 * 2;
+    bool headerOk = binary.compare(0, 4, "NPHM") == 0 &&
+                    static_cast<unsigned char>(binary[6]) == 2 &&
+                    static_cast<unsigned char>(binary[8]) == 168;
+    size_t cells = 10 + 6;
+    unsigned int first = static_cast<unsigned char>(binary[cells]) |
+                         (static_cast<unsigned char>(binary[cells + 1]) << 8);
+    if (json.find(R"({"zoneId":"ZA","average":[60.0,null)") == std::string::npos ||
+        binary.size() != expectedBinary || !headerOk || first != 6000) {
+        std::cout << "❌ Unexpected payload" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Payloads encode averages" << std::endl;
+    
+    // Analytics feeds the heatmap from occupancy samples
+    std::cout << "\nTest 4: Heatmap from Analytics samples..." << std::endl;
+    Zone* zoneA = new Zone("ZA", "Zone A", 10, 5.0);
+    Zone* zones[] = {zoneA};
+    Analytics analytics(nullptr, 0, zones, 1);
+    for (int i = 0; i < 4; i++) zoneA->allocateSlot();
+    analytics.sampleOccupancy(monday + 9 * 3600);
+    analytics.sampleOccupancy(monday + 9 * 3600 + 60);
+    std::string cached = analytics.getHeatmapJson();
+    std::cout << "Mon 09h: " << analytics.getHeatmap().getAverage(0, 9) << "%" << std::endl;
+    if (std::fabs(analytics.getHeatmap().getAverage(0, 9) - 40.0) > 1e-9 ||
+        cached != analytics.getHeatmap().toJson()) {
+        std::cout << "❌ Heatmap not fed by samples" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Heatmap updated on each sample" << std::endl;
+    delete zoneA;
+    
+    // The served payload: occupancy samples taken by the parking system
+    std::cout << "\nTest 5: Heatmap through ParkingSystem..." << std::endl;
+    ParkingSystem system;
+    system.initializeZones();
+    std::string empty = system.getHeatmapJson();
+    for (int i = 0; i < 5; i++) system.requestParking("HM" + std::to_string(i), "ZA", 2);
+    system.recordOccupancySample(monday + 9 * 3600);
+    system.recordOccupancySample(monday + 9 * 3600 + 60);
+    std::string served = system.getHeatmapJson();
+    std::cout << "ZA Mon 09h: " << cellValue(served, "ZA", 9) << "%, ZB Mon 09h: "
+              << cellValue(served, "ZB", 9) << "%" << std::endl;
+    if (cellValue(empty, "ZA", 9) != "null" || cellValue(served, "ZA", 9) != "25.0" ||
+        cellValue(served, "ZB", 9) != "0.0" || cellValue(served, "ZA", 10) != "null") {
+        std::cout << "❌ Served heatmap not fed by samples:\n" << served << std::endl;
+        return 1;
+    }
+    std::cout << "✅ /api/heatmap payload reflects sampled occupancy" << std::endl;
+    
+    std::cout << "\n=== All Occupancy Heatmap Tests Complete! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include "include/HttpServer.h"
+#include "include/Metrics.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cstring>
+#include <chrono>
+
+// Connect to the server on localhost
+static int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout;
+    timeout.tv_sec = 2;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read until `count` occurrences of marker arrive, the peer closes, or timeout
+static std::string readUntil(int fd, const std::string& marker, int count) {
+    std::string data;
+    char buffer[4096];
+    while (true) {
+        int seen = 0;
+        for (size_t pos = data.find(marker); pos != std::string::npos; pos = data.find(marker, pos + 1)) {
+            seen++;
+        }
+        if (seen >= count) break;
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        data.append(buffer, static_cast<size_t>(n));
+    }
+    return data;
+}
+
+int main() {
+    std::cout << "=== Testing Epoll HTTP Server ===\n" << std::endl;
+
+    // Incremental parsing of a request split across reads
+    std::cout << "Test 1: Incremental parsing..." << std::endl;
+    std::string raw = "POST /api/request-parking?debug=1 HTTP/1.1\r\nHost: x\r\n"
+                      "Content-Type: application/json\r\nContent-Length: 11\r\n\r\n{\"a\":\"bcd\"}";
+    HttpRequestParser parser;
+    std::string buffer;
+    ParseResult result = PARSE_INCOMPLETE;
+    for (char c : raw) {
+        buffer.push_back(c);
+        result = parser.parse(buffer);
+        if (result != PARSE_INCOMPLETE) break;
+    }
+    const HttpRequest& request = parser.getRequest();
+    if (result != PARSE_COMPLETE || request.method != "POST" || request.path != "/api/request-parking" ||
+        request.getQueryParam("debug") != "1" || request.getHeader("content-type") != "application/json" ||
+        request.body != "{\"a\":\"bcd\"}" || !request.keepAlive ||
+        parser.getMessageLength() != raw.size()) {
+        std::cout << "❌ Byte-by-byte parse failed" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Request parsed one byte at a time" << std::endl;
+
+    // Malformed and oversized requests
+    std::cout << "\nTest 2: Rejecting bad requests..." << std::endl;
+    HttpRequestParser bad;
+    bool rejected = bad.parse("GARBAGE\r\n\r\n") == PARSE_ERROR && bad.getErrorStatus() == 400;
+    bad.reset();
+    rejected = rejected && bad.parse("POST / HTTP/1.1\r\nContent-Length: 99999999\r\n\r\n") == PARSE_ERROR &&
+               bad.getErrorStatus() == 413;
+    bad.reset();
+    rejected = rejected && bad.parse("GET / HTTP/1.0\r\n\r\n") == PARSE_COMPLETE && !bad.getRequest().keepAlive;
+    if (!rejected) {
+        std::cout << "❌ Bad request handling wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Errors mapped to 400/413, HTTP/1.0 closes by default" << std::endl;
+
+    // Live server: pipelined keep-alive requests on one connection
+    std::cout << "\nTest 3: Keep-alive and pipelining over loopback..." << std::endl;
+    HttpServer server(0, 2);
+    server.route("GET", "/ping", [](const HttpRequest&, HttpResponse& res) {
+        res.contentType = "text/plain";
+        res.body = "pong";
+    });
+    server.route("POST", "/echo", [](const HttpRequest& req, HttpResponse& res) {
+        res.body = std::string(req.body);
+    });
+    if (!server.start()) {
+        std::cout << "❌ Server failed to start" << std::endl;
+        return 1;
+    }
+    std::thread serverThread([&server]() { server.run(); });
+
+    int fd = connectTo(server.getPort());
+    std::string pipelined = "GET /ping HTTP/1.1\r\nHost: t\r\n\r\n"
+                            "POST /echo HTTP/1.1\r\nHost: t\r\nContent-Length: 7\r\n\r\n{\"x\":1}"
+                            "GET /missing HTTP/1.1\r\nHost: t\r\n\r\n";
+    send(fd, pipelined.data(), pipelined.size(), 0);
+    std::string replies = readUntil(fd, "HTTP/1.1 ", 3);
+    bool ok = replies.find("pong") != std::string::npos &&
+              replies.find("{\"x\":1}") != std::string::npos &&
+              replies.find("404 Not Found") != std::string::npos &&
+              replies.find("Connection: keep-alive") != std::string::npos;
+
+    // HEAD answers with GET's headers and no body; the next response follows directly
+    std::string headThenGet = "HEAD /ping HTTP/1.1\r\nHost: t\r\n\r\n"
+                              "GET /ping HTTP/1.1\r\nHost: t\r\n\r\n";
+    send(fd, headThenGet.data(), headThenGet.size(), 0);
+    std::string headReplies = readUntil(fd, "pong", 1);
+    size_t headEnd = headReplies.find("\r\n\r\n");
+    bool headOk = headReplies.compare(0, 15, "HTTP/1.1 200 OK") == 0 &&
+                  headReplies.find("Content-Length: 4\r\n") < headEnd &&
+                  headEnd != std::string::npos &&
+                  headReplies.compare(headEnd + 4, 15, "HTTP/1.1 200 OK") == 0 &&
+                  headReplies.find("pong") == headReplies.size() - 4;
+    if (!headOk) {
+        std::cout << "❌ HEAD response carried a body:\n" << headReplies << std::endl;
+        return 1;
+    }
+
+    // Body split across two writes on the same connection
+    std::string head = "POST /echo HTTP/1.1\r\nHost: t\r\nContent-Length: 10\r\nConnection: close\r\n\r\nhello";
+    send(fd, head.data(), head.size(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    send(fd, "world", 5, 0);
+    std::string last = readUntil(fd, "helloworld", 1);
+    char probe;
+    bool closed = recv(fd, &probe, 1, 0) == 0;
+    close(fd);
+
+    server.stop();
+    serverThread.join();
+
+    std::cout << "Worker loops: " << server.getWorkerCount() << std::endl;
+    if (!ok || last.find("Connection: close") == std::string::npos || !closed) {
+        std::cout << "❌ Loopback exchange failed:\n" << replies << last << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Pipelined requests answered in order, HEAD sent without body, close honored" << std::endl;
+
+    // Event stream: published events reach every subscriber
+    std::cout << "\nTest 4: Server-Sent Events..." << std::endl;
+    HttpServer streamServer(0, 2);
+    streamServer.route("GET", "/events", [](const HttpRequest&, HttpResponse& res) {
+        res.openStream("zones");
+        res.body = "event: snapshot\ndata: []\n\n";
+    });
+    streamServer.start();
+    std::thread streamThread([&streamServer]() { streamServer.run(); });
+    int first = connectTo(streamServer.getPort());
+    int second = connectTo(streamServer.getPort());
+    std::string subscribe = "GET /events HTTP/1.1\r\nHost: t\r\n\r\n";
+    send(first, subscribe.data(), subscribe.size(), 0);
+    send(second, subscribe.data(), subscribe.size(), 0);
+    std::string firstHead = readUntil(first, "data: []\n\n", 1);
+    readUntil(second, "data: []\n\n", 1);
+    for (int i = 0; i < 100 && streamServer.getStreamCount() < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    streamServer.publish("zones", "event: zones\ndata: [{\"zoneId\":\"Z1\"}]\n\n");
+    streamServer.publish("other", "event: ignored\n\n");
+    std::string firstEvent = readUntil(first, "\n\n", 1);
+    std::string secondEvent = readUntil(second, "\n\n", 1);
+    int streams = streamServer.getStreamCount();
+    close(first);
+    close(second);
+    streamServer.stop();
+    streamThread.join();
+
+    if (firstHead.find("Content-Type: text/event-stream") == std::string::npos ||
+        firstHead.find("Content-Length") != std::string::npos || streams != 2 ||
+        firstEvent.find("Z1") == std::string::npos || secondEvent.find("Z1") == std::string::npos ||
+        firstEvent.find("ignored") != std::string::npos) {
+        std::cout << "❌ Stream delivery failed:\n" << firstHead << firstEvent << std::endl;
+        return 1;
+    }
+    std::cout << "✅ One published event delivered to " << streams << " subscribers" << std::endl;
+
+    // Thread-per-core: every worker listens on the same port
+    std::cout << "\nTest 5: SO_REUSEPORT listeners..." << std::endl;
+    HttpServer coreServer(0, 3);
+    coreServer.setThreadPerCore(true);
+    coreServer.route("GET", "/ping", [](const HttpRequest&, HttpResponse& res) {
+        res.contentType = "text/plain";
+        res.body = "pong";
+    });
+    if (!coreServer.start()) {
+        std::cout << "❌ Thread-per-core server failed to start" << std::endl;
+        return 1;
+    }
+    std::thread coreThread([&coreServer]() { coreServer.run(); });
+    int answered = 0;
+    for (int i = 0; i < 12; i++) {
+        int client = connectTo(coreServer.getPort());
+        std::string ping = "GET /ping HTTP/1.1\r\nHost: t\r\nConnection: close\r\n\r\n";
+        send(client, ping.data(), ping.size(), 0);
+        if (readUntil(client, "pong", 1).find("pong") != std::string::npos) answered++;
+        close(client);
+    }
+    coreServer.stop();
+    coreThread.join();
+    if (answered != 12 || !coreServer.isThreadPerCore()) {
+        std::cout << "❌ Only " << answered << "/12 connections answered" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ 12 connections served by " << coreServer.getWorkerCount()
+              << " per-core listeners on port " << coreServer.getPort() << std::endl;
+
+    // Every route gets a latency histogram in the process-wide registry
+    std::cout << "\nTest 6: Route metrics..." << std::endl;
+    std::string scrape;
+    metrics().writePrometheus(scrape);
+    std::string pingCount = "nexuspark_http_request_duration_seconds_count{route=\"GET /ping\"} ";
+    size_t countPos = scrape.find(pingCount);
+    long pings = countPos == std::string::npos ? 0 : std::stol(scrape.substr(countPos + pingCount.size()));
+    if (pings < 12 || scrape.find("nexuspark_http_request_duration_seconds_bucket{route=\"GET /ping\",le=\"+Inf\"}") == std::string::npos ||
+        scrape.find("nexuspark_http_responses_total{code=\"2xx\"}") == std::string::npos) {
+        std::cout << "❌ Route metrics missing:\n" << scrape << std::endl;
+        return 1;
+    }
+    std::cout << "✅ " << pings << " GET /ping requests timed" << std::endl;
+
+    std::cout << "\n=== All HTTP Server Tests Complete! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "include/JsonWriter.h"
+#include "include/Zone.h"
+#include "include/ParkingRequest.h"
+#include "include/Analytics.h"
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <limits>
+
+int main() {
+    std::cout << "=== Testing JSON Writer ===\n" << std::endl;
+    
+    // Structure, commas and nesting
+    std::cout << "Test 1: Nested objects and arrays..." << std::endl;
+    std::string out;
+    JsonWriter writer(out);
+    writer.beginObject()
+          .field("ok", true)
+          .field("count", 3)
+          .key("items").beginArray().value(1).value("two").null().beginArray().endArray().endArray()
+          .key("empty").beginObject().endObject()
+          .endObject();
+    std::cout << out << std::endl;
+    if (out != R"({"ok":true,"count":3,"items":[1,"two",null,[]],"empty":{}})" || writer.getDepth() != 0 ||
+        writer.hasFailed()) {
+        std::cout << "❌ Wrong structure" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Separators placed correctly" << std::endl;
+    
+    // Escaping
+    std::cout << "\nTest 2: String escaping..." << std::endl;
+    out.clear();
+    JsonWriter escaped(out);
+    escaped.value(std::string("say \"hi\"\\ \n\t\x01 caf\xC3\xA9"));
+    std::cout << out << std::endl;
+    if (out != "\"say \\\"hi\\\"\\\\ \\n\\t\\u0001 caf\xC3\xA9\"") {
+        std::cout << "❌ Escaping wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Quotes, backslashes and control characters escaped" << std::endl;
+    
+    // Numbers
+    std::cout << "\nTest 3: Number formatting..." << std::endl;
+    out.clear();
+    JsonWriter numbers(out);
+    numbers.beginArray()
+           .value(0.1)
+           .value(12.5, 2)
+           .value(-7)
+           .value(std::numeric_limits<int64_t>::min())
+           .value(static_cast<uint64_t>(18446744073709551615ULL))
+           .value(std::numeric_limits<double>::infinity())
+           .value(1e21)
+           .endArray();
+    std::cout << out << std::endl;
+    if (out != "[0.1,12.50,-7,-9223372036854775808,18446744073709551615,null,1e+21]") {
+        std::cout << "❌ Number formatting wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Shortest doubles, fixed precision and 64-bit integers" << std::endl;
+    
+    // Domain objects serialize themselves
+    std::cout << "\nTest 4: Zone, request and analytics objects..." << std::endl;
+    Zone* zone = new Zone("ZA", "Downtown \"A\"", 10, 5.0);
+    zone->allocateSlot();
+    ParkingRequest* request = new ParkingRequest("REQ001", "CAR001", "ZA");
+    request->allocate("ZA", "A-1", 15.0, false);
+    Zone* zones[] = {zone};
+    ParkingRequest* requests[] = {request};
+    Analytics analytics(requests, 1, zones, 1);
+    
+    out.clear();
+    JsonWriter domain(out);
+    domain.beginArray();
+    zone->writeJson(domain);
+    request->writeJson(domain);
+    analytics.writeJson(domain);
+    domain.endArray();
+    std::cout << out << std::endl;
+    bool ok = out.find(R"("zoneName":"Downtown \"A\"","totalSlots":10,"availableSlots":9,"hourlyRate":5,"utilization":10.0)") != std::string::npos &&
+              out.find(R"("requestId":"REQ001","vehicleId":"CAR001","vehicleType":"CAR")") != std::string::npos &&
+              out.find(R"("state":"ALLOCATED")") != std::string::npos &&
+              out.find(R"("totalCost":15.00)") != std::string::npos &&
+              out.find(R"("totalRequests":1)") != std::string::npos &&
+              analytics.generateReportJson().find(R"("peakZone":"ZA")") != std::string::npos;
+    delete request;
+    delete zone;
+    if (!ok) {
+        std::cout << "❌ Domain serialization wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Objects serialize through the writer" << std::endl;
+    
+    // Nesting past MAX_DEPTH and unbalanced closes fail instead of
+    // silently misplacing commas
+    std::cout << "\nTest 5: Depth limit..." << std::endl;
+    out.clear();
+    JsonWriter deep(out);
+    int levels = JsonWriter::MAX_DEPTH + 8;
+    for (int i = 0; i < levels; i++) deep.beginArray();
+    int peak = deep.getDepth();
+    for (int i = 0; i < levels; i++) deep.endArray();
+    std::string balanced;
+    JsonWriter extra(balanced);
+    extra.beginArray().endArray().endArray();
+    std::cout << "Peak depth " << peak << ", back to " << deep.getDepth() << std::endl;
+    if (!deep.hasFailed() || peak != levels || deep.getDepth() != 0 || !extra.hasFailed()) {
+        std::cout << "❌ Depth overflow not reported" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Overflow and extra close mark the writer failed" << std::endl;
+    
+    std::cout << "\n=== All JSON Writer Tests Complete! ===" << std::endl;
+    return 0;
+}
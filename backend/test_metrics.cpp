@@ -0,0 +1,137 @@
+#include "include/Metrics.h"
+#include "include/ParkingSystem.h"
+#include "include/RollbackManager.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Value of the sample line starting with prefix, or -1 if absent
+static double sampleValue(const std::string& text, const std::string& prefix) {
+    size_t pos = text.find("\n" + prefix + " ");
+    if (pos == std::string::npos) return -1.0;
+    return std::stod(text.substr(pos + prefix.size() + 2));
+}
+
+// Count occurrences of a substring
+static int occurrences(const std::string& text, const std::string& needle) {
+    int count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) count++;
+    return count;
+}
+
+int main() {
+    std::cout << "=== Testing Metrics Registry ===\n" << std::endl;
+
+    // Bucket boundaries
+    std::cout << "Test 1: Histogram buckets..." << std::endl;
+    bool bucketsOk = MetricHistogram::bucketFor(0) == 0 && MetricHistogram::bucketFor(1024) == 0 &&
+                     MetricHistogram::bucketFor(1025) == 1 && MetricHistogram::bucketFor(4096) == 1 &&
+                     MetricHistogram::bucketFor(4097) == 2 &&
+                     MetricHistogram::bucketFor(MetricHistogram::getUpperBoundNanos(11)) == 11 &&
+                     MetricHistogram::bucketFor(MetricHistogram::getUpperBoundNanos(11) + 1) == 12 &&
+                     MetricHistogram::bucketFor(~0ULL) == 12 &&
+                     MetricHistogram::getUpperBoundNanos(1) == 4096 && MetricHistogram::getUpperBoundNanos(12) == 0;
+    if (!bucketsOk) {
+        std::cout << "❌ Bucket boundaries wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Upper bounds 1.024us * 4^k, inclusive, overflow to +Inf" << std::endl;
+
+    // Concurrent recording
+    std::cout << "\nTest 2: Sharded counters across threads..." << std::endl;
+    MetricsRegistry registry;
+    MetricCounter& hits = registry.counter("test_hits_total", "Hits", MetricsRegistry::label("path", "/a"));
+    MetricHistogram& latency = registry.histogram("test_latency_seconds", "Latency");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&hits, &latency]() {
+            for (int i = 0; i < 100000; i++) {
+                hits.increment();
+                latency.record(2000);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    bool sameSeries = &registry.counter("test_hits_total", "Hits", MetricsRegistry::label("path", "/a")) == &hits;
+    if (hits.getValue() != 400000 || latency.getCount() != 400000 || latency.getBucketCount(1) != 400000 ||
+        latency.getSumNanos() != 800000000ULL || !sameSeries) {
+        std::cout << "❌ Lost updates: " << hits.getValue() << std::endl;
+        return 1;
+    }
+    std::cout << "✅ 400000 increments from 4 threads, none lost" << std::endl;
+
+    // Exposition format
+    std::cout << "\nTest 3: Prometheus text format..." << std::endl;
+    registry.counter("test_hits_total", "Hits", MetricsRegistry::label("path", "say \"hi\"")).increment(3);
+    registry.gauge("test_depth", "Depth").set(-2);
+    MetricHistogram& mixed = registry.histogram("test_mixed_seconds", "Mixed",
+                                                MetricsRegistry::label("route", "GET /x"));
+    mixed.record(500);
+    mixed.record(2000);
+    mixed.record(10000000000ULL);
+    std::string text = "\n";
+    registry.writePrometheus(text);
+    std::cout << text.substr(1, text.find("# HELP test_latency") - 1);
+    bool formatOk =
+        occurrences(text, "# TYPE test_hits_total counter\n") == 1 &&
+        occurrences(text, "# HELP test_hits_total Hits\n") == 1 &&
+        sampleValue(text, "test_hits_total{path=\"/a\"}") == 400000 &&
+        sampleValue(text, "test_hits_total{path=\"say \\\"hi\\\"\"}") == 3 &&
+        text.find("# TYPE test_depth gauge\ntest_depth -2\n") != std::string::npos &&
+        text.find("# TYPE test_mixed_seconds histogram\n") != std::string::npos &&
+        sampleValue(text, "test_mixed_seconds_bucket{route=\"GET /x\",le=\"1.024e-06\"}") == 1 &&
+        sampleValue(text, "test_mixed_seconds_bucket{route=\"GET /x\",le=\"4.096e-06\"}") == 2 &&
+        sampleValue(text, "test_mixed_seconds_bucket{route=\"GET /x\",le=\"4.294967296\"}") == 2 &&
+        sampleValue(text, "test_mixed_seconds_bucket{route=\"GET /x\",le=\"+Inf\"}") == 3 &&
+        sampleValue(text, "test_mixed_seconds_count{route=\"GET /x\"}") == 3 &&
+        text.find("test_mixed_seconds_sum{route=\"GET /x\"} 10.0000025\n") != std::string::npos &&
+        registry.getFamilyCount() == 4;
+    if (!formatOk) {
+        std::cout << "❌ Unexpected exposition:\n" << text << std::endl;
+        return 1;
+    }
+    std::cout << "✅ One HELP/TYPE per family, cumulative buckets, sum in seconds" << std::endl;
+
+    // Core instrumentation through the process-wide registry
+    std::cout << "\nTest 4: Allocation, path finding and rollback..." << std::endl;
+    ParkingSystem system;
+    system.initializeZones();
+    int allocated = 0;
+    for (int i = 0; i < 21; i++) {
+        if (!system.requestParking("M" + std::to_string(i), "ZA", 1).empty()) allocated++;
+    }
+    // ZA holds 20; the overflow request is routed to a connected zone
+    Zone* zone = new Zone("ZR", "Rollback Zone", 4, 2.0);
+    ParkingRequest* request = new ParkingRequest("RQ1", "M99", "ZR");
+    Zone* zones[] = {zone};
+    ParkingRequest* requests[] = {request};
+    RollbackManager rollback(5);
+    zone->allocateSlot();
+    rollback.pushOperation(new RollbackOperation(OP_ALLOCATE, "RQ1", "ZR", "ZR-1", REQUESTED));
+    rollback.undoLastOperation(requests, 1, zones, 1);
+    std::string scrape = "\n";
+    metrics().writePrometheus(scrape);
+    bool instrumented =
+        allocated == 21 &&
+        sampleValue(scrape, "nexuspark_allocations_total{result=\"preferred\"}") == 20 &&
+        sampleValue(scrape, "nexuspark_allocations_total{result=\"cross_zone\"}") == 1 &&
+        sampleValue(scrape, "nexuspark_allocation_duration_seconds_count") == 21 &&
+        sampleValue(scrape, "nexuspark_pathfinder_duration_seconds_count{query=\"shortest_path\"}") > 0 &&
+        sampleValue(scrape, "nexuspark_rollback_undo_total{result=\"ok\"}") == 1 &&
+        sampleValue(scrape, "nexuspark_rollback_duration_seconds_count") == 1 &&
+        sampleValue(scrape, "nexuspark_rollback_stack_depth") >= 0 &&
+        zone->getAvailableSlots() == 4;
+    if (!instrumented) {
+        std::cout << "❌ Missing core metrics:\n" << scrape << std::endl;
+        return 1;
+    }
+    delete request;
+    delete zone;
+    std::cout << "✅ 20 preferred + 1 cross-zone allocation, "
+              << sampleValue(scrape, "nexuspark_pathfinder_duration_seconds_count{query=\"shortest_path\"}")
+              << " shortest-path queries, 1 undo" << std::endl;
+
+    std::cout << "\n=== All Metrics Tests Complete! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "include/OccupancySeries.h"
+#include "include/Analytics.h"
+#include <iostream>
+
+int main() {
+    std::cout << "=== Testing Occupancy Time Series ===\n" << std::endl;
+    
+    // Record two hours of samples, one every 30 seconds
+    std::cout << "Test 1: Recording samples..." << std::endl;
+    OccupancySeries series;
+    time_t base = 1700000000 - (1700000000 % 3600);
+    for (int i = 0; i < 240; i++) {
+        double occupancy = (i < 120) ? 20.0 : 80.0;
+        series.recordSample(base + i * 30, occupancy);
+    }
+    std::cout << "✅ Recorded 240 samples" << std::endl;
+    
+    // Query each resolution
+    std::cout << "\nTest 2: Querying resolutions..." << std::endl;
+    std::vector<OccupancyBucket> minutes = series.query(base, base + 7199, RESOLUTION_MINUTE);
+    std::vector<OccupancyBucket> quarters = series.query(base, base + 7199, RESOLUTION_15_MINUTES);
+    std::vector<OccupancyBucket> hours = series.query(base, base + 7199, RESOLUTION_HOUR);
+    std::cout << "Minute buckets: " << minutes.size() << " (expected 120)" << std::endl;
+    std::cout << "15-minute buckets: " << quarters.size() << " (expected 8)" << std::endl;
+    std::cout << "Hour buckets: " << hours.size() << " (expected 2)" << std::endl;
+    if (minutes.size() != 120 || quarters.size() != 8 || hours.size() != 2) {
+        std::cout << "❌ Unexpected bucket count" << std::endl;
+        return 1;
+    }
+    std::cout << "Hour 1 average: " << hours[0].getAverage() << "%" << std::endl;
+    std::cout << "Hour 2 average: " << hours[1].getAverage() << "%" << std::endl;
+    
+    // Old minute buckets are overwritten after a day
+    std::cout << "\nTest 3: Bounded memory..." << std::endl;
+    series.recordSample(base + 2 * 86400, 50.0);
+    std::vector<OccupancyBucket> stale = series.query(base, base + 7199, RESOLUTION_MINUTE);
+    std::vector<OccupancyBucket> kept = series.query(base, base + 7199, RESOLUTION_HOUR);
+    std::cout << "Minute buckets from two days ago: " << stale.size() << " (expected 0)" << std::endl;
+    std::cout << "Hour buckets from two days ago: " << kept.size() << " (expected 2)" << std::endl;
+    if (!stale.empty() || kept.size() != 2) {
+        std::cout << "❌ Ring did not expire old buckets correctly" << std::endl;
+        return 1;
+    }
+    
+    // Analytics samples zone utilization
+    std::cout << "\nTest 4: Analytics occupancy sampling..." << std::endl;
+    Zone zoneA("ZA", "Zone A", 10, 5.0);
+    Zone* zones[] = {&zoneA};
+    Analytics analytics(nullptr, 0, zones, 1);
+    for (int i = 0; i < 4; i++) zoneA.allocateSlot();
+    analytics.sampleOccupancy(base);
+    std::vector<OccupancyBucket> zoneSeries =
+        analytics.getOccupancySeries("ZA", base, base + 59, RESOLUTION_MINUTE);
+    if (zoneSeries.size() != 1) {
+        std::cout << "❌ Missing zone sample" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Zone A occupancy: " << zoneSeries[0].getAverage() << "%" << std::endl;
+    
+    std::cout << "\n=== All Occupancy Series Tests Complete! ===" << std::endl;
+    return 0;
+}
@@ -96,8 +96,40 @@ int main() {
         std::cout << "\n❌ No available zone found" << std::endl;
     }
     
+    // One PathFinder answers many queries; earlier searches must not leak
+    // into later ones
+    std::cout << "\nTest 5: Repeated Queries..." << std::endl;
+    const int expected[5][5] = {
+        {0, 500, 800, 1200, 1200},
+        {500, 0, 300, 700, 700},
+        {800, 300, 0, 1000, 400},
+        {1200, 700, 1000, 0, 600},
+        {1200, 700, 400, 600, 0}
+    };
+    int wrong = 0;
+    for (int round = 0; round < 2; round++) {
+        for (int from = 0; from < 5; from++) {
+            for (int to = 0; to < 5; to++) {
+                if (from == to) continue;
+                std::vector<std::string> route = pathFinder.findShortestPath(zones[from], zones[to], zones, 5);
+                bool ends = !route.empty() && route.front() == zones[from]->getZoneId() &&
+                            route.back() == zones[to]->getZoneId();
+                if (!ends || pathFinder.calculateDistance(route, zones, 5) != expected[from][to]) {
+                    std::cout << "Wrong route " << zones[from]->getZoneId() << " -> "
+                              << zones[to]->getZoneId() << std::endl;
+                    wrong++;
+                }
+            }
+        }
+    }
+    if (wrong > 0) {
+        std::cout << "❌ " << wrong << " of 40 routes wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ All 40 routes shortest, twice over" << std::endl;
+    
     // Cleanup
-    std::cout << "\nTest 5: Cleanup..." << std::endl;
+    std::cout << "\nTest 6: Cleanup..." << std::endl;
     for (int i = 0; i < 5; i++) {
         delete zones[i];
     }
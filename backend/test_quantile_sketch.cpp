@@ -0,0 +1,81 @@
+#include "include/QuantileSketch.h"
+#include "include/Analytics.h"
+#include <iostream>
+#include <cmath>
+
+// Check an estimate is within the sketch's relative accuracy (plus slack)
+bool closeTo(double estimate, double expected) {
+    return std::fabs(estimate - expected) <= expected * 0.02 + 1e-9;
+}
+
+int main() {
+    std::cout << "=== Testing Quantile Sketch ===\n" << std::endl;
+    
+    // Uniform values 1..10000
+    std::cout << "Test 1: Adding 10000 samples..." << std::endl;
+    QuantileSketch sketch;
+    for (int i = 1; i <= 10000; i++) {
+        sketch.add(i);
+    }
+    std::cout << "Count: " << sketch.getCount() << ", Mean: " << sketch.getMean() << std::endl;
+    
+    std::cout << "\nTest 2: Quantiles..." << std::endl;
+    double p50 = sketch.quantile(0.50);
+    double p95 = sketch.quantile(0.95);
+    double p99 = sketch.quantile(0.99);
+    std::cout << "p50: " << p50 << " (expected ~5000)" << std::endl;
+    std::cout << "p95: " << p95 << " (expected ~9500)" << std::endl;
+    std::cout << "p99: " << p99 << " (expected ~9900)" << std::endl;
+    if (!closeTo(p50, 5000) || !closeTo(p95, 9500) || !closeTo(p99, 9900)) {
+        std::cout << "❌ Quantile outside error bound" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Quantiles within 2%" << std::endl;
+    
+    // Merge two halves
+    std::cout << "\nTest 3: Merging shards..." << std::endl;
+    QuantileSketch low, high;
+    for (int i = 1; i <= 5000; i++) low.add(i);
+    for (int i = 5001; i <= 10000; i++) high.add(i);
+    low.merge(high);
+    std::cout << "Merged p95: " << low.quantile(0.95) << std::endl;
+    if (low.getCount() != sketch.getCount() || low.quantile(0.95) != p95) {
+        std::cout << "❌ Merged sketch differs from single sketch" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Merged sketch matches single sketch" << std::endl;
+    
+    // Analytics distributions on release
+    std::cout << "\nTest 4: Analytics distributions..." << std::endl;
+    Zone zoneA("ZA", "Zone A", 10, 5.0);
+    Zone* zones[] = {&zoneA};
+    Analytics analytics(nullptr, 0, zones, 1);
+    
+    ParkingRequest carRequest("REQ001", "CAR001", "ZA", CAR);
+    carRequest.setDurationHours(2);
+    analytics.trackRequest(&carRequest);
+    carRequest.allocate("ZA", "A-1", 10.0, false);
+    carRequest.occupy();
+    carRequest.release();
+    
+    ParkingRequest truckRequest("REQ002", "TRUCK001", "ZA", TRUCK);
+    truckRequest.setDurationHours(4);
+    analytics.trackRequest(&truckRequest);
+    truckRequest.allocate("ZA", "A-2", 40.0, false);
+    truckRequest.occupy();
+    truckRequest.release();
+    
+    std::cout << "Overall median duration: " << analytics.getOverallDistribution().duration.quantile(0.5) << std::endl;
+    std::cout << "Truck p99 cost: $" << analytics.getTypeDistribution(TRUCK).cost.quantile(0.99) << std::endl;
+    std::cout << "Bike samples: " << analytics.getTypeDistribution(BIKE).cost.getCount() << std::endl;
+    const UsageDistribution* zoneDist = analytics.getZoneDistribution("ZA");
+    if (!zoneDist || zoneDist->cost.getCount() != 2 ||
+        !closeTo(analytics.getTypeDistribution(TRUCK).cost.quantile(0.99), 40.0)) {
+        std::cout << "❌ Distributions not updated on release" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Zone ZA has " << zoneDist->cost.getCount() << " cost samples" << std::endl;
+    
+    std::cout << "\n=== All Quantile Sketch Tests Complete! ===" << std::endl;
+    return 0;
+}
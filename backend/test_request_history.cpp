@@ -0,0 +1,108 @@
+#include "include/RequestHistory.h"
+#include "include/Analytics.h"
+#include <iostream>
+#include <cmath>
+#include <random>
+
+// Fill a history with pseudo-random finished requests
+void fillHistory(RequestHistory& history, int count) {
+    const char* zoneIds[] = {"ZA", "ZB", "ZC", "ZD", "ZE"};
+    std::mt19937 rng(42);
+    for (int i = 0; i < count; i++) {
+        ParkingRequest request("REQ" + std::to_string(i), "CAR", zoneIds[rng() % 5]);
+        request.setDurationHours(1 + rng() % 8);
+        if (rng() % 4 == 0) {
+            request.cancel();
+        } else {
+            bool crossZone = rng() % 3 == 0;
+            request.allocate(zoneIds[rng() % 5], "S", 1.0 + (rng() % 4000) / 100.0, crossZone);
+            request.occupy();
+            request.release();
+        }
+        history.append(request);
+    }
+}
+
+bool aggregatesMatch(const HistoryAggregates& a, const HistoryAggregates& b) {
+    for (int s = 0; s < REQUEST_STATE_COUNT; s++) {
+        if (a.stateCounts[s] != b.stateCounts[s]) return false;
+    }
+    if (a.crossZoneCompleted != b.crossZoneCompleted) return false;
+    if (std::fabs(a.revenue - b.revenue) > 1e-6 * a.revenue) return false;
+    if (std::fabs(a.duration - b.duration) > 1e-6 * a.duration) return false;
+    if (a.revenueByZone.size() != b.revenueByZone.size()) return false;
+    for (size_t z = 0; z < a.revenueByZone.size(); z++) {
+        if (std::fabs(a.revenueByZone[z] - b.revenueByZone[z]) > 1e-6 * a.revenueByZone[z]) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Testing Columnar Request History ===\n" << std::endl;
+    
+    std::cout << "Test 1: Appending 10001 requests..." << std::endl;
+    RequestHistory history;
+    fillHistory(history, 10001);
+    std::cout << "Rows: " << history.size() << ", zones: " << history.getZoneCount() << std::endl;
+    std::cout << "AVX2 supported: " << (RequestHistory::isAvx2Supported() ? "Yes" : "No") << std::endl;
+    
+    std::cout << "\nTest 2: SIMD kernels vs scalar kernels..." << std::endl;
+    RequestHistory::setAvx2Enabled(false);
+    HistoryAggregates scalar = history.aggregate();
+    RequestHistory::setAvx2Enabled(true);
+    HistoryAggregates vectorized = history.aggregate();
+    std::cout << "Released: " << vectorized.stateCounts[RELEASED]
+              << ", cancelled: " << vectorized.stateCounts[CANCELLED]
+              << ", revenue: $" << vectorized.revenue
+              << ", cross-zone: " << vectorized.crossZoneCompleted << std::endl;
+    if (!aggregatesMatch(scalar, vectorized)) {
+        std::cout << "❌ Kernel results differ" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Kernel results match" << std::endl;
+    
+    std::cout << "\nTest 3: Partial ranges add up..." << std::endl;
+    HistoryAggregates head = history.aggregate(0, 4999);
+    HistoryAggregates tail = history.aggregate(4999, history.size());
+    long long released = head.stateCounts[RELEASED] + tail.stateCounts[RELEASED];
+    if (released != scalar.stateCounts[RELEASED]) {
+        std::cout << "❌ Range split lost rows" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Split ranges: " << released << " released" << std::endl;
+    
+    std::cout << "\nTest 4: Parallel aggregation..." << std::endl;
+    RequestHistory large;
+    fillHistory(large, 300000);
+    HistoryAggregates serial = large.aggregate();
+    HistoryAggregates parallel = large.aggregateParallel(4);
+    if (!aggregatesMatch(serial, parallel)) {
+        std::cout << "❌ Parallel aggregates differ from serial" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ 4 workers match serial: $" << parallel.revenue << std::endl;
+    
+    std::cout << "\nTest 5: Analytics archives finished requests..." << std::endl;
+    Zone zoneA("ZA", "Zone A", 10, 5.0);
+    Zone* zones[] = {&zoneA};
+    Analytics analytics(nullptr, 0, zones, 1);
+    ParkingRequest r1("REQ001", "CAR001", "ZA");
+    ParkingRequest r2("REQ002", "CAR002", "ZA");
+    analytics.trackRequest(&r1);
+    analytics.trackRequest(&r2);
+    r1.allocate("ZA", "A-1", 12.5, false);
+    r1.occupy();
+    r1.release();
+    r2.cancel();
+    HistoryAggregates archived = analytics.getHistory().aggregate();
+    std::cout << "Archived rows: " << analytics.getHistory().size()
+              << ", ZA revenue: $" << archived.revenueByZone[0] << std::endl;
+    if (analytics.getHistory().size() != 2 || archived.revenueByZone[0] != 12.5) {
+        std::cout << "❌ Analytics history incorrect" << std::endl;
+        return 1;
+    }
+    analytics.displayDetailedReport(2);
+    
+    std::cout << "\n=== All Request History Tests Complete! ===" << std::endl;
+    return 0;
+}
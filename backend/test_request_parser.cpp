@@ -0,0 +1,118 @@
+#include "include/RequestParser.h"
+#include "include/ParkingSystem.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main() {
+    std::cout << "=== Testing Request Body Parser ===\n" << std::endl;
+    
+    // Well-formed body, views into the original buffer
+    std::cout << "Test 1: Parsing a valid body..." << std::endl;
+    std::string body = R"( { "durationHours" : 3, "client":{"v":[1,"}"]}, "vehicleId":"CAR-042", "preferredZone":"ZB" } )";
+    ParkingRequestBody fields;
+    std::string_view error;
+    bool ok = parseParkingRequestBody(body, fields, error);
+    std::cout << "vehicleId=" << fields.vehicleId << " zone=" << fields.preferredZone
+              << " hours=" << fields.durationHours << std::endl;
+    if (!ok || fields.vehicleId != "CAR-042" || fields.preferredZone != "ZB" || fields.durationHours != 3 ||
+        fields.vehicleId.data() < body.data() || fields.vehicleId.data() >= body.data() + body.size()) {
+        std::cout << "❌ Valid body rejected or copied: " << error << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Fields parsed in place, unknown keys skipped" << std::endl;
+    
+    // Invalid bodies
+    std::cout << "\nTest 2: Rejecting invalid bodies..." << std::endl;
+    const char* invalid[] = {
+        "",
+        "[]",
+        R"({"vehicleId":"CAR1","preferredZone":"ZA"})",
+        R"({"vehicleId":"CAR1","preferredZone":"ZA","durationHours":0})",
+        R"({"vehicleId":"CAR1","preferredZone":"ZA","durationHours":2.5})",
+        R"({"vehicleId":"CAR\"1","preferredZone":"ZA","durationHours":2})",
+        R"({"vehicleId":"has space","preferredZone":"ZA","durationHours":2})",
+        R"({"vehicleId":"CAR1","preferredZone":"ZA","durationHours":2} x)",
+        R"({"vehicleId":"CAR1","preferredZone":"ZA","durationHours":2)",
+    };
+    for (const char* text : invalid) {
+        if (parseParkingRequestBody(text, fields, error)) {
+            std::cout << "❌ Accepted: " << text << std::endl;
+            return 1;
+        }
+        std::cout << "   rejected (" << error << ")" << std::endl;
+    }
+    std::cout << "✅ Malformed and out-of-range bodies rejected" << std::endl;
+    
+    // End to end into the core
+    std::cout << "\nTest 3: Requesting parking from parsed views..." << std::endl;
+    ParkingSystem system;
+    system.initializeZones();
+    std::string post = R"({"vehicleId":"NEWCAR7","preferredZone":"ZA","durationHours":2})";
+    parseParkingRequestBody(post, fields, error);
+    std::string requestId = system.requestParking(fields.vehicleId, fields.preferredZone, fields.durationHours);
+    const ParkingRequest* request = system.getRequest(requestId);
+    std::cout << "Request: " << requestId << std::endl;
+    if (!request || request->getVehicleId() != "NEWCAR7" || request->getAllocatedZone() != "ZA" ||
+        request->getState() != ALLOCATED || request->getTotalCost() != 10.0 ||
+        !system.requestParking("NEWCAR7", "ZZ", 2).empty()) {
+        std::cout << "❌ Core request failed" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Vehicle registered and parking allocated" << std::endl;
+    
+    // Batch bodies: bad items are reported individually
+    std::cout << "\nTest 4: Parsing a batch..." << std::endl;
+    std::string batch = R"({"operations":[
+        {"op":"request","vehicleId":"FLEET1","preferredZone":"ZB","durationHours":3},
+        {"op":"occupy","requestId":")" + requestId + R"("},
+        {"op":"fly","requestId":"REQ001"},
+        {"op":"release","requestId":42},
+        {"op":"cancel","requestId":"REQ999","note":{"x":[1,2]}}
+    ]})";
+    std::vector<BatchOperation> operations;
+    bool parsed = parseBatchBody(batch, operations, error);
+    bool rejected = !parseBatchBody("[", operations, error) &&
+                    !parseBatchBody("[]", operations, error) &&
+                    !parseBatchBody(R"({"ops":[]})", operations, error);
+    parseBatchBody(batch, operations, error);
+    if (!parsed || !rejected || operations.size() != 5 ||
+        operations[0].type != BATCH_REQUEST || operations[0].durationHours != 3 ||
+        operations[1].type != BATCH_OCCUPY || operations[2].type != BATCH_INVALID ||
+        operations[2].error != "Unknown op" || operations[3].error != "Invalid requestId" ||
+        operations[4].type != BATCH_CANCEL) {
+        std::cout << "❌ Batch parse wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ 5 items parsed, 2 rejected individually" << std::endl;
+    
+    // Applied in order with per-item results
+    std::cout << "\nTest 5: Executing a batch..." << std::endl;
+    int availableBefore = system.getTotalAvailableSlots();
+    std::string results;
+    JsonWriter writer(results);
+    int succeeded = system.executeBatch(operations, writer);
+    std::cout << results << std::endl;
+    
+    std::string lifecycle = R"([{"op":"release","requestId":")" + requestId +
+                            R"("},{"op":"release","requestId":")" + requestId + R"("}])";
+    parseBatchBody(lifecycle, operations, error);
+    std::string second;
+    JsonWriter secondWriter(second);
+    int released = system.executeBatch(operations, secondWriter);
+    std::cout << second << std::endl;
+    
+    if (succeeded != 2 || system.getTotalAvailableSlots() != availableBefore ||
+        results.find(R"("index":0,"op":"request","requestId":"REQ002","allocatedZone":"ZB")") == std::string::npos ||
+        results.find(R"("state":"OCCUPIED","success":true)") == std::string::npos ||
+        results.find(R"("success":false,"error":"Request not found")") == std::string::npos ||
+        released != 1 || system.getRequest(requestId)->getState() != RELEASED ||
+        second.find(R"("state":"RELEASED","success":false,"error":"Invalid transition from current state")") == std::string::npos) {
+        std::cout << "❌ Batch results wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Request/occupy/release applied in one pass" << std::endl;
+    
+    std::cout << "\n=== All Request Body Parser Tests Complete! ===" << std::endl;
+    return 0;
+}
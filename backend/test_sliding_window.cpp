@@ -0,0 +1,69 @@
+#include "include/SlidingWindow.h"
+#include "include/Analytics.h"
+#include <iostream>
+
+int main() {
+    std::cout << "=== Testing Sliding Window Analytics ===\n" << std::endl;
+    
+    time_t now = 1700000000;
+    
+    // Old activity followed by a recent burst of cancellations
+    std::cout << "Test 1: Recording activity..." << std::endl;
+    SlidingWindow window;
+    for (int i = 0; i < 10; i++) {
+        window.recordRequest(now - 7200 + i * 60);
+        window.recordCompletion(now - 7000 + i * 60, 10.0, 2.0, false);
+    }
+    for (int i = 0; i < 4; i++) {
+        window.recordRequest(now - 300 + i * 60);
+        window.recordCancellation(now - 240 + i * 60);
+    }
+    std::cout << "✅ Recorded 14 requests" << std::endl;
+    
+    std::cout << "\nTest 2: Windowed totals..." << std::endl;
+    WindowTotals last15 = window.getTotals(now, WINDOW_15_MINUTES);
+    WindowTotals lastDay = window.getTotals(now, WINDOW_DAY);
+    std::cout << "Last 15 min: " << last15.requests << " requests, "
+              << last15.getCancellationRate() << "% cancelled" << std::endl;
+    std::cout << "Last day: " << lastDay.requests << " requests, $"
+              << lastDay.revenue << " revenue, " << lastDay.getCancellationRate() << "% cancelled" << std::endl;
+    if (last15.requests != 4 || last15.cancelled != 4 || lastDay.requests != 14 || lastDay.completed != 10) {
+        std::cout << "❌ Wrong windowed totals" << std::endl;
+        return 1;
+    }
+    
+    std::cout << "\nTest 3: Expiry after a day..." << std::endl;
+    WindowTotals later = window.getTotals(now + 2 * 86400, WINDOW_DAY);
+    std::cout << "Requests in the day two days later: " << later.requests << " (expected 0)" << std::endl;
+    if (later.requests != 0) {
+        std::cout << "❌ Old buckets leaked into window" << std::endl;
+        return 1;
+    }
+    
+    // Analytics exposes windowed and lifetime values
+    std::cout << "\nTest 4: Analytics windowed metrics..." << std::endl;
+    Zone zoneA("ZA", "Zone A", 10, 5.0);
+    Zone* zones[] = {&zoneA};
+    Analytics analytics(nullptr, 0, zones, 1);
+    ParkingRequest r1("REQ001", "CAR001", "ZA");
+    ParkingRequest r2("REQ002", "CAR002", "ZA");
+    analytics.trackRequest(&r1);
+    analytics.trackRequest(&r2);
+    r1.allocate("ZA", "A-1", 10.0, false);
+    r1.occupy();
+    r1.release();
+    r2.cancel();
+    
+    WindowTotals recent = analytics.getWindowTotals(WINDOW_5_MINUTES, time(nullptr));
+    WindowTotals lifetime = analytics.getLifetimeTotals();
+    std::cout << "Last 5 min cancellation rate: " << recent.getCancellationRate() << "%" << std::endl;
+    std::cout << "Lifetime revenue: $" << lifetime.revenue << std::endl;
+    if (recent.requests != 2 || recent.cancelled != 1 || lifetime.revenue != 10.0) {
+        std::cout << "❌ Wrong analytics window" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Windowed and lifetime metrics agree" << std::endl;
+    
+    std::cout << "\n=== All Sliding Window Tests Complete! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include "include/StaticAssetCache.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#ifdef NEXUSPARK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+// Write a file in the test directory
+static void writeFile(const std::string& path, const std::string& data) {
+    FILE* file = fopen(path.c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+}
+
+// Build a request view over raw text (the raw buffer must outlive the request)
+static bool parseRequest(HttpRequestParser& parser, const std::string& raw) {
+    parser.reset();
+    return parser.parse(raw) == PARSE_COMPLETE;
+}
+
+// Body bytes of a filled response
+static std::string responseBody(const HttpResponse& response) {
+    return response.sharedBody ? *response.sharedBody : response.body;
+}
+
+#ifdef NEXUSPARK_HAVE_ZLIB
+// Inflate a gzip stream
+static std::string gunzip(const std::string& data) {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    inflateInit2(&stream, 15 + 16);
+    std::string out;
+    char buffer[16 * 1024];
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    int result;
+    do {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        out.append(buffer, sizeof(buffer) - stream.avail_out);
+    } while (result == Z_OK);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END ? out : std::string();
+}
+#endif
+
+int main() {
+    std::cout << "=== Testing Static Asset Cache ===\n" << std::endl;
+
+    char dirTemplate[] = "/tmp/nexuspark_assets_XXXXXX";
+    std::string dir = mkdtemp(dirTemplate);
+    std::string html = "<!DOCTYPE html><html><body>";
+    for (int i = 0; i < 200; i++) html += "<div class=\"zone\">Zone card</div>";
+    html += "</body></html>";
+    writeFile(dir + "/index.html", html);
+    writeFile(dir + "/app.js", "console.log(1);");
+
+    StaticAssetCache cache(dir, 64 * 1024);
+    cache.reload();
+
+    // Encoding negotiation
+    std::cout << "Test 1: Content negotiation..." << std::endl;
+    HttpRequestParser parser;
+    std::string plainRaw = "GET / HTTP/1.1\r\nHost: t\r\n\r\n";
+    std::string gzipRaw = "GET /index.html HTTP/1.1\r\nHost: t\r\nAccept-Encoding: gzip, deflate\r\n\r\n";
+    HttpResponse plain;
+    parseRequest(parser, plainRaw);
+    bool found = cache.serve(parser.getRequest(), plain);
+    HttpResponse gzipped;
+    parseRequest(parser, gzipRaw);
+    cache.serve(parser.getRequest(), gzipped);
+
+    std::shared_ptr<const StaticAsset> asset = cache.find("/index.html");
+    bool ok = found && cache.getAssetCount() == 2 && asset && asset->inMemory &&
+              responseBody(plain) == html && plain.contentType.find("text/html") == 0;
+#ifdef NEXUSPARK_HAVE_ZLIB
+    std::string packed = responseBody(gzipped);
+    ok = ok && packed.size() < html.size() && gunzip(packed) == html;
+    std::cout << "gzip: " << html.size() << " -> " << packed.size() << " bytes" << std::endl;
+#endif
+    // Tiny files are not worth compressing
+    std::shared_ptr<const StaticAsset> script = cache.find("/app.js");
+    ok = ok && script && !script->gzip && !script->brotli;
+    if (!ok) {
+        std::cout << "❌ Negotiation failed" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Identity and compressed variants served from memory" << std::endl;
+
+    // Conditional GET
+    std::cout << "\nTest 2: If-None-Match..." << std::endl;
+    std::string conditionalRaw = "GET / HTTP/1.1\r\nHost: t\r\nIf-None-Match: " + asset->etag + "\r\n\r\n";
+    HttpResponse notModified;
+    parseRequest(parser, conditionalRaw);
+    cache.serve(parser.getRequest(), notModified);
+    std::string staleRaw = "GET / HTTP/1.1\r\nHost: t\r\nIf-None-Match: \"stale\"\r\n\r\n";
+    HttpResponse fresh;
+    parseRequest(parser, staleRaw);
+    cache.serve(parser.getRequest(), fresh);
+    if (notModified.status != 304 || responseBody(notModified) != "" || fresh.status != 200) {
+        std::cout << "❌ Conditional GET wrong" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Matching ETag answered with 304 (" << asset->etag << ")" << std::endl;
+
+    // Reload on change
+    std::cout << "\nTest 3: inotify reload..." << std::endl;
+    cache.startWatching();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    uint64_t before = cache.getGeneration();
+    writeFile(dir + "/index.html", "<html>v2</html>");
+    for (int i = 0; i < 40 && cache.getGeneration() == before; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    std::shared_ptr<const StaticAsset> updated = cache.find("/index.html");
+    cache.stopWatching();
+    if (!updated || *updated->identity != "<html>v2</html>" || updated->etag == asset->etag) {
+        std::cout << "❌ Cache did not reload" << std::endl;
+        return 1;
+    }
+    // The old snapshot stays valid for requests still holding it
+    std::cout << "✅ Reloaded after write; old snapshot still " << asset->identity->size() << " bytes" << std::endl;
+
+    // Large file over a real socket
+    std::cout << "\nTest 4: sendfile for uncached files..." << std::endl;
+    std::string large(200 * 1024, 'x');
+    for (size_t i = 0; i < large.size(); i += 97) large[i] = static_cast<char>('a' + i % 26);
+    writeFile(dir + "/map.bin", large);
+    cache.reload();
+
+    HttpServer server(0, 1);
+    server.setFallback([&cache](const HttpRequest& req, HttpResponse& res) {
+        if (!cache.serve(req, res)) {
+            res.status = 404;
+            res.body = "missing";
+        }
+    });
+    if (!server.start()) {
+        std::cout << "❌ Server failed to start" << std::endl;
+        return 1;
+    }
+    std::thread serverThread([&server]() { server.run(); });
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout;
+    timeout.tv_sec = 2;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(server.getPort()));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    std::string get = "GET /map.bin HTTP/1.1\r\nHost: t\r\nConnection: close\r\n\r\n";
+    send(fd, get.data(), get.size(), 0);
+    std::string reply;
+    char buffer[16 * 1024];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) reply.append(buffer, static_cast<size_t>(n));
+    close(fd);
+    server.stop();
+    serverThread.join();
+
+    size_t headerEnd = reply.find("\r\n\r\n");
+    std::shared_ptr<const StaticAsset> mapAsset = cache.find("/map.bin");
+    if (!mapAsset || mapAsset->inMemory || headerEnd == std::string::npos ||
+        reply.find("Content-Length: 204800") == std::string::npos ||
+        reply.substr(headerEnd + 4) != large) {
+        std::cout << "❌ Large file transfer failed (" << reply.size() << " bytes)" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ " << large.size() << " bytes streamed from disk" << std::endl;
+
+    remove((dir + "/index.html").c_str());
+    remove((dir + "/app.js").c_str());
+    remove((dir + "/map.bin").c_str());
+    rmdir(dir.c_str());
+
+    std::cout << "\n=== All Static Asset Tests Complete! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "include/TopKTracker.h"
+#include "include/Analytics.h"
+#include <iostream>
+
+int main() {
+    std::cout << "=== Testing Top-K Heavy Hitter Tracker ===\n" << std::endl;
+    
+    // Exact counts while under capacity
+    std::cout << "Test 1: Counting under capacity..." << std::endl;
+    TopKTracker tracker(16);
+    for (int i = 0; i < 50; i++) tracker.offer("ZA");
+    for (int i = 0; i < 30; i++) tracker.offer("ZB");
+    for (int i = 0; i < 10; i++) tracker.offer("ZC");
+    std::vector<HeavyHitter> top = tracker.top(2);
+    for (const HeavyHitter& hitter : top) {
+        std::cout << "   " << hitter.key << ": " << hitter.count << std::endl;
+    }
+    if (top.size() != 2 || top[0].key != "ZA" || top[0].count != 50 || top[1].key != "ZB") {
+        std::cout << "❌ Wrong top-2" << std::endl;
+        return 1;
+    }
+    
+    // Heavy keys survive a stream of rare keys
+    std::cout << "\nTest 2: Bounded memory with many rare keys..." << std::endl;
+    for (int i = 0; i < 1000; i++) {
+        tracker.offer("RARE" + std::to_string(i));
+        if (i % 2 == 0) tracker.offer("ZA");
+    }
+    std::cout << "Tracked keys: " << tracker.getSize() << " (capacity " << tracker.getCapacity() << ")" << std::endl;
+    top = tracker.top(1);
+    std::cout << "Top key: " << top[0].key << " (" << top[0].count << ", error " << top[0].error << ")" << std::endl;
+    if (tracker.getSize() != 16 || top[0].key != "ZA") {
+        std::cout << "❌ Heavy hitter lost" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Heavy hitter retained" << std::endl;
+    
+    // Analytics peak zones and overflow routes
+    std::cout << "\nTest 3: Analytics peak usage..." << std::endl;
+    Zone zoneA("ZA", "Zone A", 10, 5.0);
+    Zone zoneB("ZB", "Zone B", 10, 5.0);
+    Zone* zones[] = {&zoneA, &zoneB};
+    Analytics analytics(nullptr, 0, zones, 2);
+    
+    ParkingRequest r1("REQ001", "CAR001", "ZA");
+    ParkingRequest r2("REQ002", "CAR001", "ZA");
+    ParkingRequest r3("REQ003", "CAR002", "ZB");
+    analytics.trackRequest(&r1);
+    analytics.trackRequest(&r2);
+    analytics.trackRequest(&r3);
+    r1.allocate("ZB", "B-1", 10.0, true);
+    r2.allocate("ZB", "B-2", 10.0, true);
+    r3.allocate("ZB", "B-3", 5.0, false);
+    
+    std::cout << "Peak usage zone: " << analytics.getPeakUsageZone() << std::endl;
+    std::vector<HeavyHitter> vehicles = analytics.getTopVehicles(1);
+    std::vector<HeavyHitter> routes = analytics.getTopOverflowRoutes(1);
+    std::cout << "Top vehicle: " << vehicles[0].key << " (" << vehicles[0].count << ")" << std::endl;
+    std::cout << "Top overflow route: " << routes[0].key << " (" << routes[0].count << ")" << std::endl;
+    if (analytics.getPeakUsageZone() != "ZB" || vehicles[0].key != "CAR001" ||
+        routes[0].key != "ZA->ZB" || routes[0].count != 2) {
+        std::cout << "❌ Wrong analytics heavy hitters" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Analytics heavy hitters correct" << std::endl;
+    
+    std::cout << "\n=== All Top-K Tests Complete! ===" << std::endl;
+    return 0;
+}
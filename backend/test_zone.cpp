@@ -68,6 +68,18 @@ int main() {
     }
     std::cout << "Available slots after release: " << zoneA.getAvailableSlots() << std::endl;
     
+    // Test change versions
+    std::cout << "\nTest 7: Testing Change Versions..." << std::endl;
+    uint64_t before = Zone::getCurrentVersion();
+    zoneB.allocateSlot();
+    if (zoneB.getVersion() != before + 1 || zoneA.getVersion() > before ||
+        Zone::getCurrentVersion() != before + 1) {
+        std::cout << "❌ Version not taken from the global counter" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Zone B at version " << zoneB.getVersion() << ", Zone A unchanged at "
+              << zoneA.getVersion() << std::endl;
+    
     std::cout << "\n=== All Zone Tests Complete! ===" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "include/ZoneStatusBuffer.h"
+#include "include/ParkingSystem.h"
+#include "include/Zone.h"
+#include <iostream>
+#include <string>
+
+// Strip all spaces so padded fields compare easily
+static std::string compact(const std::string& json) {
+    std::string out;
+    for (char c : json) {
+        if (c != ' ') out.push_back(c);
+    }
+    return out;
+}
+
+int main() {
+    std::cout << "=== Testing Zone Status Buffer ===\n" << std::endl;
+    
+    Zone* zoneA = new Zone("ZA", "Downtown Parking A", 20, 5.0);
+    Zone* zoneB = new Zone("ZB", "Mall Parking B", 8, 4.0);
+    zoneA->addConnection(new ZoneConnection("ZB", 500));
+    Zone* zones[] = {zoneA, zoneB};
+    
+    // The buffer observes the zones, so it must be gone before they are
+    {
+        // Initial serialization
+        std::cout << "Test 1: Initial zone list..." << std::endl;
+        ZoneStatusBuffer buffer(zones, 2);
+        std::string initial = buffer.getJson();
+        std::cout << compact(initial) << std::endl;
+        if (compact(initial).find(R"("zoneId":"ZA","zoneName":"DowntownParkingA","totalSlots":20,"availableSlots":20,"hourlyRate":5,"utilization":0.0,"connections":[{"zoneId":"ZB","distance":500}])") == std::string::npos) {
+            std::cout << "❌ Unexpected initial JSON" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Zones serialized" << std::endl;
+    
+        // Patched in place on slot changes
+        std::cout << "\nTest 2: Patching on allocation and release..." << std::endl;
+        const char* address = buffer.getJson().data();
+        for (int i = 0; i < 11; i++) zoneA->allocateSlot();
+        zoneB->allocateSlot();
+        zoneB->allocateSlot();
+        zoneB->releaseSlot();
+        std::string patched = compact(buffer.getJson());
+        std::cout << patched << std::endl;
+        if (buffer.getJson().size() != initial.size() || buffer.getJson().data() != address ||
+            patched.find(R"("availableSlots":9,"hourlyRate":5,"utilization":55.0)") == std::string::npos ||
+            patched.find(R"("availableSlots":7,"hourlyRate":4,"utilization":12.5)") == std::string::npos) {
+            std::cout << "❌ Fields not patched in place" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Availability patched without reallocation" << std::endl;
+    
+        // Full and empty extremes still fit the fixed-width fields
+        std::cout << "\nTest 3: Field width extremes..." << std::endl;
+        while (zoneB->allocateSlot()) {}
+        patched = compact(buffer.getJson());
+        if (buffer.getJson().size() != initial.size() ||
+            patched.find(R"("availableSlots":0,"hourlyRate":4,"utilization":100.0)") == std::string::npos) {
+            std::cout << "❌ Full zone not encoded" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Full zone encoded in the same width" << std::endl;
+    
+        // Change queue coalesces repeated changes per zone
+        std::cout << "\nTest 4: Coalesced deltas..." << std::endl;
+        std::string deltas;
+        int drained = buffer.takeChanges(deltas);
+        std::string empty;
+        int again = buffer.takeChanges(empty);
+        zoneA->releaseSlot();
+        zoneA->releaseSlot();
+        std::string next;
+        int changedAfter = buffer.takeChanges(next);
+        std::cout << deltas << "\n" << next << std::endl;
+        if (drained != 2 || again != 0 || empty != "[]" || changedAfter != 1 ||
+            deltas.find(R"({"zoneId":"ZA","availableSlots":9,"utilization":55.0})") == std::string::npos ||
+            deltas.find(R"({"zoneId":"ZB","availableSlots":0,"utilization":100.0})") == std::string::npos ||
+            next != R"([{"zoneId":"ZA","availableSlots":11,"utilization":45.0}])") {
+            std::cout << "❌ Deltas not coalesced" << std::endl;
+            return 1;
+        }
+        std::cout << "✅ Many slot changes drained as one delta per zone" << std::endl;
+
+    }
+    delete zoneA;
+    delete zoneB;
+    
+    // Versioned sync through the parking system
+    std::cout << "\nTest 5: Delta sync since a version..." << std::endl;
+    ParkingSystem system;
+    system.initializeZones();
+    uint64_t baseline = system.getZoneVersion();
+    system.requestParking("SYNC1", "ZB", 2);
+    std::string delta;
+    JsonWriter deltaWriter(delta);
+    system.writeZonesSince(deltaWriter, baseline);
+    std::string full;
+    JsonWriter fullWriter(full);
+    system.writeZonesSince(fullWriter, 0);
+    std::string current;
+    JsonWriter currentWriter(current);
+    system.writeZonesSince(currentWriter, system.getZoneVersion());
+    system.requestParking("SYNC2", "ZA", 2);
+    system.requestParking("SYNC3", "ZC", 2);
+    std::string behind;
+    JsonWriter behindWriter(behind);
+    system.writeZonesSince(behindWriter, baseline);
+    std::cout << delta << std::endl;
+    
+    std::string newVersion = std::to_string(baseline + 1);
+    if (delta != R"({"version":)" + newVersion +
+                 R"(,"full":false,"changed":1,"zones":[{"zoneId":"ZB","availableSlots":14,"utilization":6.7}]})" ||
+        full.find(R"("full":true,"changed":5)") == std::string::npos ||
+        current.find(R"("changed":0,"zones":[]})") == std::string::npos ||
+        behind.find(R"("full":true,"changed":5)") == std::string::npos) {
+        std::cout << "❌ Delta sync wrong:\n" << full << "\n" << current << "\n" << behind << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Only changed zones sent; full list for new or lagging clients" << std::endl;
+    
+    std::cout << "\n=== All Zone Status Buffer Tests Complete! ===" << std::endl;
+    return 0;
+}